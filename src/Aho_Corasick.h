@@ -0,0 +1,110 @@
+#ifndef SPEEDREADER_AHO_CORASICK_H
+#define SPEEDREADER_AHO_CORASICK_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <queue>
+#include <cstddef>
+
+namespace mjd {
+
+    // Aho-Corasick automaton over a set of byte string patterns, used to find
+    // every pattern occurring in a text in a single scan (Aho and Corasick,
+    // 1975).
+    class AhoCorasick {
+    public:
+        explicit AhoCorasick(const std::vector<std::string>& patterns) {
+            nodes.push_back(Node());
+            for (size_t p = 0; p < patterns.size(); ++p) {
+                int node = 0;
+                for (size_t k = 0; k < patterns[p].size(); ++k) {
+                    unsigned char c = patterns[p][k];
+                    std::map<unsigned char, int>::const_iterator edge =
+                        nodes[node].next.find(c);
+                    if (edge == nodes[node].next.end()) {
+                        nodes[node].next[c] = nodes.size();
+                        node = nodes.size();
+                        nodes.push_back(Node());
+                    } else {
+                        node = edge->second;
+                    }
+                }
+                nodes[node].patterns.push_back(p);
+            }
+
+            // breadth first, so every node's failure link is set before its
+            // children's.
+            std::queue<int> queue;
+            for (std::map<unsigned char, int>::const_iterator edge =
+                     nodes[0].next.begin(); edge != nodes[0].next.end(); ++edge) {
+                nodes[edge->second].fail = 0;
+                queue.push(edge->second);
+            }
+            while (!queue.empty()) {
+                int node = queue.front();
+                queue.pop();
+                int fail = nodes[node].fail;
+                nodes[node].output = nodes[fail].patterns.empty() ?
+                    nodes[fail].output : fail;
+                for (std::map<unsigned char, int>::const_iterator edge =
+                         nodes[node].next.begin();
+                     edge != nodes[node].next.end(); ++edge) {
+                    nodes[edge->second].fail = transition(fail, edge->first);
+                    queue.push(edge->second);
+                }
+            }
+        }
+
+        // Call f(pattern) once for every occurrence of every pattern in text.
+        // Empty patterns are reported once per text.
+        template <typename F>
+        void find_all(const std::string& text, F f) const {
+            report(0, f);
+            int node = 0;
+            for (size_t k = 0; k < text.size(); ++k) {
+                node = transition(node, text[k]);
+                for (int match = node; match > 0; match = nodes[match].output) {
+                    report(match, f);
+                }
+            }
+        }
+
+    private:
+        struct Node {
+            std::map<unsigned char, int> next;
+            std::vector<int> patterns;
+            // longest proper suffix that is a trie node, and the nearest
+            // such suffix that ends a pattern (0 if none).
+            int fail;
+            int output;
+            Node() : fail(0), output(0) {}
+        };
+
+        int transition(int node, unsigned char c) const {
+            while (true) {
+                std::map<unsigned char, int>::const_iterator edge =
+                    nodes[node].next.find(c);
+                if (edge != nodes[node].next.end()) {
+                    return edge->second;
+                }
+                if (node == 0) {
+                    return 0;
+                }
+                node = nodes[node].fail;
+            }
+        }
+
+        template <typename F>
+        void report(int node, F& f) const {
+            for (size_t k = 0; k < nodes[node].patterns.size(); ++k) {
+                f(nodes[node].patterns[k]);
+            }
+        }
+
+        std::vector<Node> nodes;
+    };
+
+}
+
+#endif
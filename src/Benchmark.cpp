@@ -0,0 +1,114 @@
+// [[Rcpp::plugins(cpp11)]]
+#include <RcppArmadillo.h>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include "Zipf_Corpus.h"
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+//[[Rcpp::depends(RcppArmadillo)]]
+using namespace Rcpp;
+
+namespace mjd {
+    CharacterVector utf8_character_vector(const std::vector<std::string>& v);
+}
+
+// Generates a seeded synthetic corpus (see Zipf_Corpus.h). Returns a list of
+// token vectors, the one based index of the document each near duplicate
+// was copied from (NA for originals), and the vocabulary in rank order.
+// [[Rcpp::export]]
+List Generate_Zipf_Corpus(int num_documents,
+                          int vocabulary_size,
+                          double exponent,
+                          double mean_length,
+                          double length_sd,
+                          double duplicate_rate,
+                          double edit_rate,
+                          double seed){
+
+    mjd::ZipfCorpusOptions options;
+    options.num_documents = num_documents;
+    options.vocabulary_size = vocabulary_size;
+    options.exponent = exponent;
+    options.mean_length = mean_length;
+    options.length_sd = length_sd;
+    options.duplicate_rate = duplicate_rate;
+    options.edit_rate = edit_rate;
+    options.seed = uint64_t(seed);
+
+    std::vector<std::vector<int> > ranks;
+    std::vector<int> sources;
+    mjd::generate_zipf_corpus(options, ranks, sources);
+
+    std::vector<std::string> vocabulary(vocabulary_size);
+    for (int r = 0; r < vocabulary_size; ++r) {
+        vocabulary[r] = mjd::zipf_term(r);
+    }
+    List documents(num_documents);
+    IntegerVector duplicate_of(num_documents);
+    std::vector<std::string> tokens;
+    for (int d = 0; d < num_documents; ++d) {
+        tokens.resize(ranks[d].size());
+        for (size_t k = 0; k < ranks[d].size(); ++k) {
+            tokens[k] = vocabulary[ranks[d][k]];
+        }
+        documents[d] = mjd::utf8_character_vector(tokens);
+        duplicate_of[d] = sources[d] < 0 ? NA_INTEGER : sources[d] + 1;
+    }
+
+    List to_return(3);
+    to_return[0] = documents;
+    to_return[1] = duplicate_of;
+    to_return[2] = mjd::utf8_character_vector(vocabulary);
+    return to_return;
+}
+
+// Seconds on a monotonic clock with sub-microsecond resolution, for timing
+// individual kernel calls.
+// [[Rcpp::export]]
+double Benchmark_Clock(){
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Resets the peak resident set size reported by Peak_Resident_Memory(),
+// where the platform allows it (Linux). Returns whether it was reset.
+// [[Rcpp::export]]
+bool Reset_Peak_Resident_Memory(){
+#if defined(__linux__)
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    clear_refs << "5";
+    clear_refs.close();
+    return !clear_refs.fail();
+#else
+    return false;
+#endif
+}
+
+// Peak resident set size of the R process in bytes, since it started or
+// since the last successful Reset_Peak_Resident_Memory(). NA on Windows.
+// [[Rcpp::export]]
+double Peak_Resident_Memory(){
+#if defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) {
+            return std::atof(line.c_str() + 6) * 1024;
+        }
+    }
+#endif
+#if !defined(_WIN32)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+        return double(usage.ru_maxrss);
+#else
+        return double(usage.ru_maxrss) * 1024;
+#endif
+    }
+#endif
+    return NA_REAL;
+}
@@ -0,0 +1,344 @@
+#ifndef SPEEDREADER_BLOCK_FILE_H
+#define SPEEDREADER_BLOCK_FILE_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace mjd {
+
+    // Binary document term block format. A block holds a list of documents as
+    // one stream of uint32 term ids into a string table shared by every
+    // document in the block, so it can be memory-mapped and walked without
+    // deserializing anything. All values are little endian and every section
+    // starts on an eight byte boundary:
+    //
+    //   BlockHeader                       64 bytes
+    //   document offsets                  uint64[num_documents + 1]
+    //   term ids                          uint32[num_tokens]
+    //   counts (if BLOCK_HAS_COUNTS)      double[num_tokens]
+    //   string offsets                    uint64[num_strings + 1]
+    //   string data                       char[string_bytes], UTF-8
+    //
+    // Document i is ids[offsets[i]] ... ids[offsets[i + 1] - 1]. The string
+    // table lists terms in the order they first appear in the block.
+    const char BLOCK_MAGIC[8] = {'S', 'R', 'D', 'T', 'B', 'L', 'K', '\0'};
+    const uint32_t BLOCK_VERSION = 1;
+    const uint32_t BLOCK_HAS_COUNTS = 1;
+
+    struct BlockHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t flags;
+        uint64_t num_documents;
+        uint64_t num_tokens;
+        uint64_t num_strings;
+        uint64_t string_bytes;
+        uint64_t byte_order;
+        uint64_t reserved;
+    };
+
+    const uint64_t BLOCK_BYTE_ORDER = 0x0102030405060708ULL;
+
+    inline uint64_t block_align(uint64_t n) {
+        return (n + 7) & ~uint64_t(7);
+    }
+
+    // Read-only view of a whole file. Uses mmap() so that forked or threaded
+    // readers of the same block share pages through the OS cache. On Windows
+    // the file is read into memory instead.
+    class MappedFile {
+    public:
+        MappedFile() : begin(0), length(0) {}
+
+        ~MappedFile() {
+            close();
+        }
+
+        bool open(const std::string& path, std::string& error) {
+            close();
+#if defined(_WIN32)
+            std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+            if (!file) {
+                error = "Could not open file: " + path;
+                return false;
+            }
+            file.seekg(0, std::ios::end);
+            std::streamoff size = file.tellg();
+            file.seekg(0, std::ios::beg);
+            buffer.resize(size_t(size));
+            if (size > 0 && !file.read(&buffer[0], size)) {
+                error = "Could not read file: " + path;
+                return false;
+            }
+            begin = buffer.empty() ? 0 : &buffer[0];
+            length = buffer.size();
+#else
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) {
+                error = "Could not open file: " + path;
+                return false;
+            }
+            struct stat info;
+            if (fstat(fd, &info) != 0) {
+                ::close(fd);
+                error = "Could not stat file: " + path;
+                return false;
+            }
+            length = size_t(info.st_size);
+            if (length > 0) {
+                void* mapped = mmap(0, length, PROT_READ, MAP_SHARED, fd, 0);
+                if (mapped == MAP_FAILED) {
+                    ::close(fd);
+                    length = 0;
+                    error = "Could not memory map file: " + path;
+                    return false;
+                }
+                begin = static_cast<const char*>(mapped);
+            }
+            // the mapping stays valid after the descriptor is closed.
+            ::close(fd);
+#endif
+            return true;
+        }
+
+        void close() {
+#if defined(_WIN32)
+            std::vector<char>().swap(buffer);
+#else
+            if (begin != 0) {
+                munmap(const_cast<char*>(begin), length);
+            }
+#endif
+            begin = 0;
+            length = 0;
+        }
+
+        const char* data() const {
+            return begin;
+        }
+
+        size_t size() const {
+            return length;
+        }
+
+    private:
+        MappedFile(const MappedFile&);
+        MappedFile& operator=(const MappedFile&);
+
+        const char* begin;
+        size_t length;
+#if defined(_WIN32)
+        std::vector<char> buffer;
+#endif
+    };
+
+    // Zero-copy reader for a document term block.
+    class BlockReader {
+    public:
+        BlockReader()
+            : offsets(0), ids(0), counts(0), string_offsets(0), strings(0) {
+            std::memset(&header, 0, sizeof(header));
+        }
+
+        bool open(const std::string& path, std::string& error) {
+            if (!file.open(path, error)) {
+                return false;
+            }
+            if (file.size() < sizeof(BlockHeader)) {
+                error = "Not a document term block: " + path;
+                return false;
+            }
+            std::memcpy(&header, file.data(), sizeof(BlockHeader));
+            if (std::memcmp(header.magic, BLOCK_MAGIC, 8) != 0) {
+                error = "Not a document term block: " + path;
+                return false;
+            }
+            if (header.byte_order != BLOCK_BYTE_ORDER) {
+                error = "Document term block was written on a machine with a different byte order: " + path;
+                return false;
+            }
+            if (header.version != BLOCK_VERSION) {
+                error = "Unsupported document term block version: " + path;
+                return false;
+            }
+
+            uint64_t position = sizeof(BlockHeader);
+            uint64_t offsets_at = position;
+            position = block_align(position + 8 * (header.num_documents + 1));
+            uint64_t ids_at = position;
+            position = block_align(position + 4 * header.num_tokens);
+            uint64_t counts_at = position;
+            if (has_counts()) {
+                position = block_align(position + 8 * header.num_tokens);
+            }
+            uint64_t string_offsets_at = position;
+            position = block_align(position + 8 * (header.num_strings + 1));
+            uint64_t strings_at = position;
+            position += header.string_bytes;
+            if (position > file.size()) {
+                error = "Document term block is truncated: " + path;
+                return false;
+            }
+
+            const char* base = file.data();
+            offsets = reinterpret_cast<const uint64_t*>(base + offsets_at);
+            ids = reinterpret_cast<const uint32_t*>(base + ids_at);
+            counts = has_counts() ?
+                reinterpret_cast<const double*>(base + counts_at) : 0;
+            string_offsets =
+                reinterpret_cast<const uint64_t*>(base + string_offsets_at);
+            strings = base + strings_at;
+
+            if (offsets[header.num_documents] != header.num_tokens ||
+                string_offsets[header.num_strings] != header.string_bytes) {
+                error = "Document term block is corrupt: " + path;
+                return false;
+            }
+            // check every offset and id once here so kernels can index
+            // without bounds checks.
+            for (uint64_t i = 0; i < header.num_documents; ++i) {
+                if (offsets[i] > offsets[i + 1]) {
+                    error = "Document term block is corrupt: " + path;
+                    return false;
+                }
+            }
+            for (uint64_t i = 0; i < header.num_strings; ++i) {
+                if (string_offsets[i] > string_offsets[i + 1]) {
+                    error = "Document term block is corrupt: " + path;
+                    return false;
+                }
+            }
+            for (uint64_t k = 0; k < header.num_tokens; ++k) {
+                if (ids[k] >= header.num_strings) {
+                    error = "Document term block is corrupt: " + path;
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        size_t num_documents() const {
+            return header.num_documents;
+        }
+
+        size_t num_tokens() const {
+            return header.num_tokens;
+        }
+
+        size_t num_strings() const {
+            return header.num_strings;
+        }
+
+        bool has_counts() const {
+            return (header.flags & BLOCK_HAS_COUNTS) != 0;
+        }
+
+        size_t document_length(size_t i) const {
+            return offsets[i + 1] - offsets[i];
+        }
+
+        const uint32_t* document_ids(size_t i) const {
+            return ids + offsets[i];
+        }
+
+        // returns null if the block stores full term sequences.
+        const double* document_counts(size_t i) const {
+            return counts == 0 ? 0 : counts + offsets[i];
+        }
+
+        const char* term_data(uint32_t id) const {
+            return strings + string_offsets[id];
+        }
+
+        size_t term_length(uint32_t id) const {
+            return string_offsets[id + 1] - string_offsets[id];
+        }
+
+        std::string term(uint32_t id) const {
+            return std::string(term_data(id), term_length(id));
+        }
+
+    private:
+        MappedFile file;
+        BlockHeader header;
+        const uint64_t* offsets;
+        const uint32_t* ids;
+        const double* counts;
+        const uint64_t* string_offsets;
+        const char* strings;
+    };
+
+    // Write a block. counts may be null, otherwise it must have one entry per
+    // term id. Returns false and sets error if the file cannot be written.
+    inline bool write_document_term_block(
+            const std::string& path,
+            const std::vector<uint64_t>& document_offsets,
+            const std::vector<uint32_t>& term_ids,
+            const std::vector<double>* counts,
+            const std::vector<std::string>& terms,
+            std::string& error) {
+        BlockHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, BLOCK_MAGIC, 8);
+        header.version = BLOCK_VERSION;
+        header.flags = counts == 0 ? 0 : BLOCK_HAS_COUNTS;
+        header.num_documents = document_offsets.size() - 1;
+        header.num_tokens = term_ids.size();
+        header.num_strings = terms.size();
+        header.byte_order = BLOCK_BYTE_ORDER;
+
+        std::vector<uint64_t> string_offsets(terms.size() + 1, 0);
+        for (size_t k = 0; k < terms.size(); ++k) {
+            string_offsets[k + 1] = string_offsets[k] + terms[k].size();
+        }
+        header.string_bytes = string_offsets[terms.size()];
+
+        std::ofstream out(path.c_str(), std::ios::out | std::ios::binary |
+                          std::ios::trunc);
+        if (!out) {
+            error = "Could not open file for writing: " + path;
+            return false;
+        }
+        const char padding[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+        uint64_t position = 0;
+        // write n bytes and then pad out to the next section boundary.
+        auto write_section = [&](const void* data, uint64_t n) {
+            if (n > 0) {
+                out.write(static_cast<const char*>(data), n);
+            }
+            position += n;
+            uint64_t aligned = block_align(position);
+            out.write(padding, aligned - position);
+            position = aligned;
+        };
+        write_section(&header, sizeof(header));
+        write_section(document_offsets.data(), 8 * document_offsets.size());
+        write_section(term_ids.data(), 4 * term_ids.size());
+        if (counts != 0) {
+            write_section(counts->data(), 8 * counts->size());
+        }
+        write_section(string_offsets.data(), 8 * string_offsets.size());
+        for (size_t k = 0; k < terms.size(); ++k) {
+            out.write(terms[k].data(), terms[k].size());
+        }
+        out.flush();
+        if (!out) {
+            error = "Could not write file: " + path;
+            return false;
+        }
+        return true;
+    }
+
+}
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef SPEEDREADER_BOUNDED_QUEUE_H
+#define SPEEDREADER_BOUNDED_QUEUE_H
+
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+namespace mjd {
+
+    // A fixed capacity multi-producer multi-consumer queue used to connect the
+    // stages of the native pipelines. push() blocks while the queue is full and
+    // pop() blocks while it is empty. Once close() has been called, pop()
+    // drains whatever is left and then returns false.
+    template <typename T>
+    class BoundedQueue {
+    public:
+        explicit BoundedQueue(size_t capacity)
+            : capacity(capacity < 1 ? 1 : capacity), closed(false) {}
+
+        // returns false if the queue was closed before the item could be added.
+        bool push(T item) {
+            std::unique_lock<std::mutex> lock(mutex);
+            not_full.wait(lock, [this] {
+                return items.size() < capacity || closed;
+            });
+            if (closed) {
+                return false;
+            }
+            items.push_back(std::move(item));
+            not_empty.notify_one();
+            return true;
+        }
+
+        bool pop(T& item) {
+            std::unique_lock<std::mutex> lock(mutex);
+            not_empty.wait(lock, [this] {
+                return !items.empty() || closed;
+            });
+            if (items.empty()) {
+                return false;
+            }
+            item = std::move(items.front());
+            items.pop_front();
+            not_full.notify_one();
+            return true;
+        }
+
+        void close() {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+            not_empty.notify_all();
+            not_full.notify_all();
+        }
+
+    private:
+        size_t capacity;
+        bool closed;
+        std::deque<T> items;
+        std::mutex mutex;
+        std::condition_variable not_empty;
+        std::condition_variable not_full;
+    };
+
+}
+
+#endif
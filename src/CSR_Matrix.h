@@ -0,0 +1,64 @@
+#ifndef SPEEDREADER_CSR_MATRIX_H
+#define SPEEDREADER_CSR_MATRIX_H
+
+#include <vector>
+#include <cstddef>
+
+namespace mjd {
+
+    // In-memory compressed sparse row document-term matrix. Row i occupies
+    // entries [row_pointers[i], row_pointers[i + 1]) of columns/values.
+    // Column ids are zero based.
+    struct CSRMatrix {
+        std::vector<size_t> row_pointers;
+        std::vector<int> columns;
+        std::vector<double> values;
+        int num_columns;
+
+        CSRMatrix() : row_pointers(1, 0), num_columns(0) {}
+
+        int num_rows() const {
+            return row_pointers.size() - 1;
+        }
+
+        size_t num_entries() const {
+            return columns.size();
+        }
+
+        void append(int column, double value) {
+            columns.push_back(column);
+            values.push_back(value);
+        }
+
+        // close the row currently being appended to.
+        void end_row() {
+            row_pointers.push_back(columns.size());
+        }
+
+        // Renumber columns using remap (new id, or -1 to drop the column) and
+        // compact the matrix in place.
+        void remap_columns(const std::vector<int>& remap, int new_num_columns) {
+            size_t out = 0;
+            size_t row_start = 0;
+            for (int i = 0; i < num_rows(); ++i) {
+                size_t row_end = row_pointers[i + 1];
+                for (size_t k = row_start; k < row_end; ++k) {
+                    int to = remap[columns[k]];
+                    if (to >= 0) {
+                        columns[out] = to;
+                        values[out] = values[k];
+                        out += 1;
+                    }
+                }
+                row_start = row_end;
+                row_pointers[i + 1] = out;
+            }
+            columns.resize(out);
+            values.resize(out);
+            num_columns = new_num_columns;
+        }
+    };
+
+}
+
+#endif
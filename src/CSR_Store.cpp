@@ -0,0 +1,373 @@
+// [[Rcpp::plugins(cpp11)]]
+#include <RcppArmadillo.h>
+#include <string>
+#include <algorithm>
+#include <fstream>
+#include <unordered_map>
+#include "CSR_Store.h"
+#include "Parallel.h"
+//[[Rcpp::depends(RcppArmadillo)]]
+using namespace Rcpp;
+
+namespace mjd {
+    void open_csr_store(const std::string& directory, CSRStore& store) {
+        std::string error;
+        if (!store.open(directory, error)) {
+            Rcpp::stop(error);
+        }
+    }
+
+    // one based triplets for slam::simple_triplet_matrix().
+    List csr_to_triplets(const CSRMatrix& matrix) {
+        size_t entries = matrix.num_entries();
+        IntegerVector i(entries);
+        IntegerVector j(entries);
+        NumericVector v(entries);
+        for (int row = 0; row < matrix.num_rows(); ++row) {
+            for (size_t k = matrix.row_pointers[row];
+                 k < matrix.row_pointers[row + 1]; ++k) {
+                i[k] = row + 1;
+                j[k] = matrix.columns[k] + 1;
+                v[k] = matrix.values[k];
+            }
+        }
+        List to_return(3);
+        to_return[0] = i;
+        to_return[1] = j;
+        to_return[2] = v;
+        return to_return;
+    }
+
+    // column statistics and row sums in a single pass over the store, with
+    // every thread accumulating over its own range of rows. Returns false if
+    // the store has a column id outside of its vocabulary.
+    bool scan_csr_store_statistics(const CSRStore& store,
+                                   int cores,
+                                   CSRStoreStatistics& statistics,
+                                   std::vector<double>& row_sums) {
+        int num_rows = store.num_rows();
+        size_t num_columns = store.num_columns();
+        int ranges = parallel_ranges(num_rows, cores);
+        std::vector<std::vector<double> > document_frequency(ranges);
+        std::vector<std::vector<double> > column_sums(ranges);
+        std::vector<double> minimum(ranges, 0);
+        std::vector<char> corrupt(ranges, 0);
+        row_sums.assign(num_rows, 0);
+        parallel_for(num_rows, cores, [&](int start, int end, int t) {
+            if (!store.valid_rows(start, end)) {
+                corrupt[t] = 1;
+                return;
+            }
+            document_frequency[t].assign(num_columns, 0);
+            column_sums[t].assign(num_columns, 0);
+            for (int i = start; i < end; ++i) {
+                for (size_t k = store.row_begin(i); k < store.row_end(i); ++k) {
+                    double value = store.value(k);
+                    uint32_t column = store.column(k);
+                    document_frequency[t][column] += value != 0;
+                    column_sums[t][column] += value;
+                    row_sums[i] += value;
+                    if (value < minimum[t]) {
+                        minimum[t] = value;
+                    }
+                }
+            }
+        });
+
+        statistics.num_rows = num_rows;
+        statistics.num_columns = num_columns;
+        statistics.minimum = 0;
+        statistics.document_frequency.assign(num_columns, 0);
+        statistics.column_sums.assign(num_columns, 0);
+        for (int t = 0; t < ranges; ++t) {
+            if (document_frequency[t].empty()) {
+                continue;
+            }
+            for (size_t c = 0; c < num_columns; ++c) {
+                statistics.document_frequency[c] += document_frequency[t][c];
+                statistics.column_sums[c] += column_sums[t][c];
+            }
+            statistics.minimum = std::min(statistics.minimum, minimum[t]);
+        }
+        return std::find(corrupt.begin(), corrupt.end(), 1) == corrupt.end();
+    }
+
+    std::vector<double> read_row_sums(const std::string& directory,
+                                      size_t num_rows) {
+        std::vector<double> row_sums(num_rows);
+        std::string path = csr_store_path(directory, "row_sums.bin");
+        std::ifstream in(path.c_str(), std::ios::in | std::ios::binary);
+        if (!in.read(reinterpret_cast<char*>(row_sums.data()), 8 * num_rows)) {
+            Rcpp::stop("Could not read file: " + path);
+        }
+        return row_sums;
+    }
+
+    bool has_csr_store_statistics(const std::string& directory,
+                                  CSRStoreStatistics& statistics) {
+        mjd::CSRStoreHeader header;
+        std::string error;
+        if (!read_csr_store_header(directory, header, error)) {
+            Rcpp::stop(error);
+        }
+        return read_csr_store_statistics(directory, header, statistics);
+    }
+}
+
+// [[Rcpp::export]]
+void Create_CSR_Store(std::string directory,
+                      std::vector<std::string> vocabulary,
+                      int value_type){
+    std::string error;
+    if (!mjd::create_csr_store(directory, vocabulary, value_type, error)) {
+        Rcpp::stop(error);
+    }
+}
+
+// [[Rcpp::export]]
+void Append_CSR_Store(std::string directory,
+                      IntegerVector i,
+                      IntegerVector j,
+                      NumericVector v,
+                      int num_rows){
+
+    // counting sort the (one based) triplets into rows, keeping the order of
+    // entries within each row.
+    mjd::CSRMatrix block;
+    size_t entries = i.size();
+    block.row_pointers.assign(num_rows + 1, 0);
+    for (size_t k = 0; k < entries; ++k) {
+        if (i[k] < 1 || i[k] > num_rows) {
+            Rcpp::stop("Row index is outside of the matrix.");
+        }
+        block.row_pointers[i[k]] += 1;
+    }
+    for (int row = 0; row < num_rows; ++row) {
+        block.row_pointers[row + 1] += block.row_pointers[row];
+    }
+    block.columns.resize(entries);
+    block.values.resize(entries);
+    std::vector<size_t> next(block.row_pointers.begin(),
+                             block.row_pointers.end() - 1);
+    for (size_t k = 0; k < entries; ++k) {
+        size_t to = next[i[k] - 1]++;
+        block.columns[to] = j[k] - 1;
+        block.values[to] = v[k];
+    }
+
+    std::string error;
+    if (!mjd::append_csr_store(directory, block, error)) {
+        Rcpp::stop(error);
+    }
+}
+
+// The dimensions and value type of a store, from its header alone, so that
+// the store object can be refreshed after each append without mapping or
+// reading any of its rows.
+// [[Rcpp::export]]
+List CSR_Store_Info(std::string directory){
+    mjd::CSRStoreHeader header;
+    std::string error;
+    if (!mjd::read_csr_store_header(directory, header, error)) {
+        Rcpp::stop(error);
+    }
+    List to_return(5);
+    to_return[0] = double(header.num_rows);
+    to_return[1] = double(header.num_columns);
+    to_return[2] = double(header.num_entries);
+    to_return[3] = int(header.value_type);
+    mjd::CSRStoreStatistics statistics;
+    to_return[4] = mjd::has_csr_store_statistics(directory, statistics);
+    return to_return;
+}
+
+// Checks every column id in a store against its vocabulary. Opening a store
+// only checks its row pointers, and readers check just the rows they read.
+// [[Rcpp::export]]
+bool Verify_CSR_Store(std::string directory){
+    mjd::CSRStore store;
+    mjd::open_csr_store(directory, store);
+    return store.valid_rows(0, store.num_rows());
+}
+
+// Adds terms to the end of a store's vocabulary as new columns.
+// [[Rcpp::export]]
+void Extend_CSR_Store_Vocabulary(std::string directory,
+                                 std::vector<std::string> terms){
+    std::string error;
+    if (!mjd::extend_csr_store_vocabulary(directory, terms, error)) {
+        Rcpp::stop(error);
+    }
+}
+
+// Recomputes the running row sums and column statistics of a store from
+// all of its rows, for stores created before they were kept or left stale
+// by a failed append.
+// [[Rcpp::export]]
+void Rebuild_CSR_Store_Statistics(std::string directory,
+                                  int cores){
+    mjd::CSRStore store;
+    mjd::open_csr_store(directory, store);
+    mjd::CSRStoreStatistics statistics;
+    std::vector<double> row_sums;
+    if (!mjd::scan_csr_store_statistics(store, cores, statistics, row_sums)) {
+        Rcpp::stop("CSR store is corrupt: " + directory);
+    }
+
+    std::string path = mjd::csr_store_path(directory, "row_sums.bin");
+    std::ofstream out(path.c_str(), std::ios::out | std::ios::binary |
+                      std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(row_sums.data()),
+              8 * row_sums.size());
+    out.close();
+    std::string error;
+    if (!out) {
+        Rcpp::stop("Could not write file: " + path);
+    }
+    if (!mjd::write_csr_store_statistics(directory, statistics, error)) {
+        Rcpp::stop(error);
+    }
+}
+
+// [[Rcpp::export]]
+List Slice_CSR_Store(std::string directory,
+                     IntegerVector rows,
+                     IntegerVector columns){
+
+    mjd::CSRStore store;
+    mjd::open_csr_store(directory, store);
+
+    // map store columns onto the (one based) subset, in subset order.
+    std::vector<int> remap;
+    int num_columns = store.num_columns();
+    int num_requested = columns.size();
+    if (num_requested > 0) {
+        remap.assign(store.num_columns(), -1);
+        for (int k = 0; k < num_requested; ++k) {
+            if (columns[k] < 1 || size_t(columns[k]) > store.num_columns()) {
+                Rcpp::stop("Column index is outside of the CSR store.");
+            }
+            if (remap[columns[k] - 1] >= 0) {
+                Rcpp::stop("Column indices may not be repeated.");
+            }
+            remap[columns[k] - 1] = k;
+        }
+        num_columns = num_requested;
+    }
+
+    mjd::CSRMatrix slice;
+    slice.num_columns = num_columns;
+    int num_rows = rows.size();
+    for (int k = 0; k < num_rows; ++k) {
+        if (rows[k] < 1 || size_t(rows[k]) > store.num_rows()) {
+            Rcpp::stop("Row index is outside of the CSR store.");
+        }
+        if (!store.valid_rows(rows[k] - 1, rows[k])) {
+            Rcpp::stop("CSR store is corrupt: " + directory);
+        }
+        store.append_row(rows[k] - 1, remap, slice);
+    }
+    return mjd::csr_to_triplets(slice);
+}
+
+// Document frequencies, column sums, row sums and the minimum value of a
+// store. These come from the running statistics kept as rows are appended
+// when they are current, and otherwise from a single pass over the store.
+// [[Rcpp::export]]
+List CSR_Store_Summary(std::string directory,
+                       int cores){
+
+    mjd::CSRStoreStatistics statistics;
+    std::vector<double> row_sums;
+    if (mjd::has_csr_store_statistics(directory, statistics)) {
+        row_sums = mjd::read_row_sums(directory, statistics.num_rows);
+    } else {
+        mjd::CSRStore store;
+        mjd::open_csr_store(directory, store);
+        if (!mjd::scan_csr_store_statistics(store, cores, statistics,
+                                            row_sums)) {
+            Rcpp::stop("CSR store is corrupt: " + directory);
+        }
+    }
+
+    List to_return(4);
+    to_return[0] = NumericVector(statistics.document_frequency.begin(),
+                                 statistics.document_frequency.end());
+    to_return[1] = NumericVector(statistics.column_sums.begin(),
+                                 statistics.column_sums.end());
+    to_return[2] = NumericVector(row_sums.begin(), row_sums.end());
+    to_return[3] = statistics.minimum;
+    return to_return;
+}
+
+// [[Rcpp::export]]
+List CSR_Store_Group_Column_Sums(std::string directory,
+                                 IntegerVector groups,
+                                 int first_row,
+                                 int cores){
+
+    // rows from the one based first_row onwards, so that a table can be
+    // brought up to date with only the rows appended since it was built.
+    mjd::CSRStore store;
+    mjd::open_csr_store(directory, store);
+    if (first_row < 1 || size_t(first_row) > store.num_rows() + 1) {
+        Rcpp::stop("Row index is outside of the CSR store.");
+    }
+    int offset = first_row - 1;
+    int num_rows = store.num_rows() - offset;
+    if (int(groups.size()) != num_rows) {
+        Rcpp::stop("There must be one group per row of the CSR store.");
+    }
+    std::vector<int> group(groups.begin(), groups.end());
+    uint64_t num_columns = store.num_columns();
+
+    // (group, column) -> sum, accumulated per thread and then merged. Rows
+    // with an NA or non-positive group are skipped.
+    int ranges = mjd::parallel_ranges(num_rows, cores);
+    std::vector<std::unordered_map<uint64_t, double> > sums(ranges);
+    std::vector<char> corrupt(ranges, 0);
+    mjd::parallel_for(num_rows, cores, [&](int start, int end, int t) {
+        if (!store.valid_rows(offset + start, offset + end)) {
+            corrupt[t] = 1;
+            return;
+        }
+        std::unordered_map<uint64_t, double>& local = sums[t];
+        for (int i = start; i < end; ++i) {
+            if (group[i] < 1) {
+                continue;
+            }
+            uint64_t base = uint64_t(group[i] - 1) * num_columns;
+            for (size_t k = store.row_begin(offset + i);
+                 k < store.row_end(offset + i); ++k) {
+                local[base + store.column(k)] += store.value(k);
+            }
+        }
+    });
+    if (std::find(corrupt.begin(), corrupt.end(), 1) != corrupt.end()) {
+        Rcpp::stop("CSR store is corrupt: " + directory);
+    }
+    for (int t = 1; t < ranges; ++t) {
+        for (std::unordered_map<uint64_t, double>::const_iterator it =
+                 sums[t].begin(); it != sums[t].end(); ++it) {
+            sums[0][it->first] += it->second;
+        }
+        std::unordered_map<uint64_t, double>().swap(sums[t]);
+    }
+
+    std::vector<std::pair<uint64_t, double> > entries(sums[0].begin(),
+                                                      sums[0].end());
+    std::sort(entries.begin(), entries.end());
+    IntegerVector i(entries.size());
+    IntegerVector j(entries.size());
+    NumericVector v(entries.size());
+    for (size_t k = 0; k < entries.size(); ++k) {
+        i[k] = entries[k].first / num_columns + 1;
+        j[k] = entries[k].first % num_columns + 1;
+        v[k] = entries[k].second;
+    }
+    List to_return(3);
+    to_return[0] = i;
+    to_return[1] = j;
+    to_return[2] = v;
+    return to_return;
+}
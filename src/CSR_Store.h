@@ -0,0 +1,566 @@
+#ifndef SPEEDREADER_CSR_STORE_H
+#define SPEEDREADER_CSR_STORE_H
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include "Block_File.h"
+#include "CSR_Matrix.h"
+
+namespace mjd {
+
+    // On-disk compressed sparse row document-term matrix. A store is a
+    // directory holding:
+    //
+    //   header.bin          CSRStoreHeader
+    //   row_pointers.bin    uint64[num_rows + 1]
+    //   columns.bin         uint32[num_entries], zero based column ids
+    //   values.bin          uint32 or float32[num_entries]
+    //   vocabulary.txt      one UTF-8 column name per line
+    //   row_sums.bin        float64[num_rows]
+    //   column_statistics.bin
+    //                       uint64 num_rows, uint64 num_columns,
+    //                       float64 minimum,
+    //                       float64 document_frequency[num_columns],
+    //                       float64 column_sums[num_columns]
+    //
+    // Rows are appended a block at a time. Data is written before the header
+    // is updated, so a failed append leaves the store as it was: readers only
+    // ever look at the num_rows / num_entries / num_columns recorded in the
+    // header. New columns may be added to the end of the vocabulary at any
+    // time; existing rows are unaffected.
+    //
+    // The row sums and column statistics are running totals updated with
+    // each append, so corpus level statistics never need a pass over the
+    // whole store. They are only trusted when they cover exactly the rows
+    // and columns in the header. Stores written before they existed, or left
+    // stale by a failed append, fall back to a full pass until the
+    // statistics are rebuilt.
+    const char CSR_STORE_MAGIC[8] = {'S', 'R', 'C', 'S', 'R', '\0', '\0', '\0'};
+    const uint32_t CSR_STORE_VERSION = 1;
+
+    enum CSRValueType {
+        CSR_VALUES_UINT32 = 0,
+        CSR_VALUES_FLOAT32 = 1
+    };
+
+    struct CSRStoreHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t value_type;
+        uint64_t num_rows;
+        uint64_t num_columns;
+        uint64_t num_entries;
+        uint64_t byte_order;
+        uint64_t reserved[2];
+    };
+
+    inline std::string csr_store_path(const std::string& directory,
+                                      const char* name) {
+        std::string path = directory;
+        if (!path.empty() && path[path.size() - 1] != '/') {
+            path += '/';
+        }
+        return path + name;
+    }
+
+    inline bool read_csr_store_header(const std::string& directory,
+                                      CSRStoreHeader& header,
+                                      std::string& error) {
+        std::string path = csr_store_path(directory, "header.bin");
+        std::ifstream in(path.c_str(), std::ios::in | std::ios::binary);
+        if (!in || !in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+            error = "Could not read CSR store header: " + path;
+            return false;
+        }
+        if (std::memcmp(header.magic, CSR_STORE_MAGIC, 8) != 0) {
+            error = "Not a CSR store: " + directory;
+            return false;
+        }
+        if (header.byte_order != BLOCK_BYTE_ORDER) {
+            error = "CSR store was written on a machine with a different byte order: " + directory;
+            return false;
+        }
+        if (header.version != CSR_STORE_VERSION) {
+            error = "Unsupported CSR store version: " + directory;
+            return false;
+        }
+        return true;
+    }
+
+    inline bool write_csr_store_header(const std::string& directory,
+                                       const CSRStoreHeader& header,
+                                       std::string& error) {
+        std::string path = csr_store_path(directory, "header.bin");
+        std::ofstream out(path.c_str(), std::ios::out | std::ios::binary |
+                          std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.flush();
+        if (!out) {
+            error = "Could not write CSR store header: " + path;
+            return false;
+        }
+        return true;
+    }
+
+    // write n bytes at byte offset position of an existing file.
+    inline bool write_at(const std::string& path,
+                         uint64_t position,
+                         const void* data,
+                         uint64_t n,
+                         std::string& error) {
+        std::fstream file(path.c_str(), std::ios::in | std::ios::out |
+                          std::ios::binary);
+        if (!file) {
+            error = "Could not open file for writing: " + path;
+            return false;
+        }
+        file.seekp(position);
+        if (n > 0) {
+            file.write(static_cast<const char*>(data), n);
+        }
+        file.flush();
+        if (!file) {
+            error = "Could not write file: " + path;
+            return false;
+        }
+        return true;
+    }
+
+    struct CSRStoreStatistics {
+        uint64_t num_rows;
+        uint64_t num_columns;
+        double minimum;
+        std::vector<double> document_frequency;
+        std::vector<double> column_sums;
+    };
+
+    // replace path with a fully written temporary file, so readers never
+    // see a partial file.
+    inline bool replace_file(const std::string& temporary,
+                             const std::string& path,
+                             std::string& error) {
+#if defined(_WIN32)
+        std::remove(path.c_str());
+#endif
+        if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+            error = "Could not replace file: " + path;
+            return false;
+        }
+        return true;
+    }
+
+    // Whether the store has statistics covering every row and column in
+    // header, which are read into statistics if so.
+    inline bool read_csr_store_statistics(const std::string& directory,
+                                          const CSRStoreHeader& header,
+                                          CSRStoreStatistics& statistics) {
+        std::string path = csr_store_path(directory, "column_statistics.bin");
+        std::ifstream in(path.c_str(), std::ios::in | std::ios::binary);
+        if (!in ||
+            !in.read(reinterpret_cast<char*>(&statistics.num_rows), 8) ||
+            !in.read(reinterpret_cast<char*>(&statistics.num_columns), 8) ||
+            !in.read(reinterpret_cast<char*>(&statistics.minimum), 8) ||
+            statistics.num_rows != header.num_rows ||
+            statistics.num_columns != header.num_columns) {
+            return false;
+        }
+        statistics.document_frequency.resize(statistics.num_columns);
+        statistics.column_sums.resize(statistics.num_columns);
+        if (!in.read(reinterpret_cast<char*>(statistics.document_frequency.data()),
+                     8 * statistics.num_columns) ||
+            !in.read(reinterpret_cast<char*>(statistics.column_sums.data()),
+                     8 * statistics.num_columns)) {
+            return false;
+        }
+        std::ifstream rows(csr_store_path(directory, "row_sums.bin").c_str(),
+                           std::ios::in | std::ios::binary | std::ios::ate);
+        return rows && uint64_t(rows.tellg()) >= 8 * header.num_rows;
+    }
+
+    inline bool write_csr_store_statistics(const std::string& directory,
+                                           const CSRStoreStatistics& statistics,
+                                           std::string& error) {
+        std::string path = csr_store_path(directory, "column_statistics.bin");
+        std::string temporary = path + ".tmp";
+        std::ofstream out(temporary.c_str(), std::ios::out | std::ios::binary |
+                          std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&statistics.num_rows), 8);
+        out.write(reinterpret_cast<const char*>(&statistics.num_columns), 8);
+        out.write(reinterpret_cast<const char*>(&statistics.minimum), 8);
+        out.write(reinterpret_cast<const char*>(statistics.document_frequency.data()),
+                  8 * statistics.num_columns);
+        out.write(reinterpret_cast<const char*>(statistics.column_sums.data()),
+                  8 * statistics.num_columns);
+        out.close();
+        if (!out) {
+            error = "Could not write file: " + temporary;
+            return false;
+        }
+        return replace_file(temporary, path, error);
+    }
+
+    // Add the rows of block to statistics, returning the sum of each row.
+    // Values going into a float32 store are rounded as they will be stored, so
+    // the statistics match a later scan of the store.
+    inline std::vector<double> add_csr_store_statistics(const CSRMatrix& block,
+                                                        int value_type,
+                                                        CSRStoreStatistics& statistics) {
+        std::vector<double> row_sums(block.num_rows(), 0);
+        bool rounded = value_type == CSR_VALUES_FLOAT32;
+        for (int i = 0; i < block.num_rows(); ++i) {
+            for (size_t k = block.row_pointers[i]; k < block.row_pointers[i + 1]; ++k) {
+                double value = block.values[k];
+                if (rounded) {
+                    value = static_cast<float>(value);
+                }
+                statistics.document_frequency[block.columns[k]] += value != 0;
+                statistics.column_sums[block.columns[k]] += value;
+                statistics.minimum = std::min(statistics.minimum, value);
+                row_sums[i] += value;
+            }
+        }
+        statistics.num_rows += block.num_rows();
+        return row_sums;
+    }
+
+    // Create an empty store in an existing directory.
+    inline bool create_csr_store(const std::string& directory,
+                                 const std::vector<std::string>& vocabulary,
+                                 int value_type,
+                                 std::string& error) {
+        if (value_type != CSR_VALUES_UINT32 && value_type != CSR_VALUES_FLOAT32) {
+            error = "Unknown CSR store value type.";
+            return false;
+        }
+        std::string path = csr_store_path(directory, "vocabulary.txt");
+        std::ofstream terms(path.c_str(), std::ios::out | std::ios::binary |
+                            std::ios::trunc);
+        for (size_t k = 0; k < vocabulary.size(); ++k) {
+            if (vocabulary[k].find('\n') != std::string::npos) {
+                error = "Vocabulary terms may not contain newlines: " +
+                    vocabulary[k];
+                return false;
+            }
+            terms << vocabulary[k] << '\n';
+        }
+        terms.flush();
+        if (!terms) {
+            error = "Could not write file: " + path;
+            return false;
+        }
+
+        const char* files[4] = {"row_pointers.bin", "columns.bin", "values.bin",
+                                "row_sums.bin"};
+        for (int f = 0; f < 4; ++f) {
+            std::string data_path = csr_store_path(directory, files[f]);
+            std::ofstream out(data_path.c_str(), std::ios::out |
+                              std::ios::binary | std::ios::trunc);
+            if (f == 0) {
+                uint64_t zero = 0;
+                out.write(reinterpret_cast<const char*>(&zero), sizeof(zero));
+            }
+            out.flush();
+            if (!out) {
+                error = "Could not write file: " + data_path;
+                return false;
+            }
+        }
+
+        CSRStoreHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, CSR_STORE_MAGIC, 8);
+        header.version = CSR_STORE_VERSION;
+        header.value_type = value_type;
+        header.num_columns = vocabulary.size();
+        header.byte_order = BLOCK_BYTE_ORDER;
+        if (!write_csr_store_header(directory, header, error)) {
+            return false;
+        }
+
+        CSRStoreStatistics statistics;
+        statistics.num_rows = 0;
+        statistics.num_columns = vocabulary.size();
+        statistics.minimum = 0;
+        statistics.document_frequency.assign(vocabulary.size(), 0);
+        statistics.column_sums.assign(vocabulary.size(), 0);
+        return write_csr_store_statistics(directory, statistics, error);
+    }
+
+    // Append the rows of block to the end of the store.
+    inline bool append_csr_store(const std::string& directory,
+                                 const CSRMatrix& block,
+                                 std::string& error) {
+        CSRStoreHeader header;
+        if (!read_csr_store_header(directory, header, error)) {
+            return false;
+        }
+        size_t entries = block.num_entries();
+        std::vector<uint32_t> columns(entries);
+        std::vector<uint32_t> integer_values;
+        std::vector<float> float_values;
+        for (size_t k = 0; k < entries; ++k) {
+            if (block.columns[k] < 0 ||
+                uint64_t(block.columns[k]) >= header.num_columns) {
+                error = "Column index is outside of the CSR store vocabulary.";
+                return false;
+            }
+            columns[k] = block.columns[k];
+        }
+        if (header.value_type == CSR_VALUES_UINT32) {
+            integer_values.resize(entries);
+            for (size_t k = 0; k < entries; ++k) {
+                double value = block.values[k];
+                if (value < 0 || value > 4294967295.0 ||
+                    value != std::floor(value)) {
+                    error = "A CSR store with integer values can only hold whole, non-negative counts. Use a float store instead.";
+                    return false;
+                }
+                integer_values[k] = uint32_t(value);
+            }
+        } else {
+            float_values.assign(block.values.begin(), block.values.end());
+        }
+        std::vector<uint64_t> pointers(block.num_rows());
+        for (int i = 0; i < block.num_rows(); ++i) {
+            pointers[i] = header.num_entries + block.row_pointers[i + 1];
+        }
+        CSRStoreStatistics statistics;
+        bool has_statistics = read_csr_store_statistics(directory, header,
+                                                        statistics);
+        std::vector<double> row_sums;
+        if (has_statistics) {
+            row_sums = add_csr_store_statistics(block, header.value_type,
+                                                statistics);
+        }
+
+        if (!write_at(csr_store_path(directory, "row_pointers.bin"),
+                      8 * (header.num_rows + 1), pointers.data(),
+                      8 * pointers.size(), error) ||
+            !write_at(csr_store_path(directory, "columns.bin"),
+                      4 * header.num_entries, columns.data(),
+                      4 * entries, error) ||
+            !write_at(csr_store_path(directory, "values.bin"),
+                      4 * header.num_entries,
+                      header.value_type == CSR_VALUES_UINT32 ?
+                      static_cast<const void*>(integer_values.data()) :
+                      static_cast<const void*>(float_values.data()),
+                      4 * entries, error)) {
+            return false;
+        }
+        if (has_statistics &&
+            !write_at(csr_store_path(directory, "row_sums.bin"),
+                      8 * header.num_rows, row_sums.data(),
+                      8 * row_sums.size(), error)) {
+            return false;
+        }
+        header.num_rows += block.num_rows();
+        header.num_entries += entries;
+        if (!write_csr_store_header(directory, header, error)) {
+            return false;
+        }
+        return !has_statistics ||
+            write_csr_store_statistics(directory, statistics, error);
+    }
+
+    // Add terms to the end of the store vocabulary, as new (empty) columns.
+    inline bool extend_csr_store_vocabulary(const std::string& directory,
+                                            const std::vector<std::string>& terms,
+                                            std::string& error) {
+        CSRStoreHeader header;
+        if (!read_csr_store_header(directory, header, error)) {
+            return false;
+        }
+        for (size_t k = 0; k < terms.size(); ++k) {
+            if (terms[k].find('\n') != std::string::npos) {
+                error = "Vocabulary terms may not contain newlines: " + terms[k];
+                return false;
+            }
+        }
+        CSRStoreStatistics statistics;
+        bool has_statistics = read_csr_store_statistics(directory, header,
+                                                        statistics);
+
+        // rewrite the vocabulary from the columns in the header, dropping any
+        // terms left by an extension that failed before the header was
+        // updated.
+        std::string path = csr_store_path(directory, "vocabulary.txt");
+        std::string temporary = path + ".tmp";
+        {
+            std::ifstream in(path.c_str(), std::ios::in | std::ios::binary);
+            std::ofstream out(temporary.c_str(), std::ios::out |
+                              std::ios::binary | std::ios::trunc);
+            std::string line;
+            for (uint64_t c = 0; c < header.num_columns; ++c) {
+                if (!std::getline(in, line)) {
+                    error = "CSR store vocabulary is truncated: " + path;
+                    return false;
+                }
+                out << line << '\n';
+            }
+            for (size_t k = 0; k < terms.size(); ++k) {
+                out << terms[k] << '\n';
+            }
+            out.close();
+            if (!out) {
+                error = "Could not write file: " + temporary;
+                return false;
+            }
+        }
+        if (!replace_file(temporary, path, error)) {
+            return false;
+        }
+
+        header.num_columns += terms.size();
+        if (!write_csr_store_header(directory, header, error)) {
+            return false;
+        }
+        if (!has_statistics) {
+            return true;
+        }
+        statistics.num_columns = header.num_columns;
+        statistics.document_frequency.resize(header.num_columns, 0);
+        statistics.column_sums.resize(header.num_columns, 0);
+        return write_csr_store_statistics(directory, statistics, error);
+    }
+
+    // Read-only memory-mapped view of a store.
+    class CSRStore {
+    public:
+        CSRStore() : pointers(0), column_ids(0), raw_values(0) {
+            std::memset(&header, 0, sizeof(header));
+        }
+
+        bool open(const std::string& directory, std::string& error) {
+            if (!read_csr_store_header(directory, header, error) ||
+                !row_file.open(csr_store_path(directory, "row_pointers.bin"),
+                               error) ||
+                !column_file.open(csr_store_path(directory, "columns.bin"),
+                                  error) ||
+                !value_file.open(csr_store_path(directory, "values.bin"),
+                                 error)) {
+                return false;
+            }
+            if (row_file.size() < 8 * (header.num_rows + 1) ||
+                column_file.size() < 4 * header.num_entries ||
+                value_file.size() < 4 * header.num_entries) {
+                error = "CSR store is truncated: " + directory;
+                return false;
+            }
+            pointers = reinterpret_cast<const uint64_t*>(row_file.data());
+            column_ids = reinterpret_cast<const uint32_t*>(column_file.data());
+            raw_values = value_file.data();
+            // rows must lie within the mapped entries. Column ids are only
+            // checked for the rows that are read (see valid_rows()), so that
+            // opening a store does not touch every page of columns.bin.
+            bool corrupt = pointers[0] != 0 ||
+                pointers[header.num_rows] != header.num_entries;
+            for (uint64_t i = 0; i < header.num_rows && !corrupt; ++i) {
+                corrupt = pointers[i + 1] < pointers[i];
+            }
+            if (corrupt) {
+                error = "CSR store is corrupt: " + directory;
+                return false;
+            }
+            return true;
+        }
+
+        size_t num_rows() const {
+            return header.num_rows;
+        }
+
+        size_t num_columns() const {
+            return header.num_columns;
+        }
+
+        size_t num_entries() const {
+            return header.num_entries;
+        }
+
+        int value_type() const {
+            return header.value_type;
+        }
+
+        size_t row_begin(size_t i) const {
+            return pointers[i];
+        }
+
+        size_t row_end(size_t i) const {
+            return pointers[i + 1];
+        }
+
+        uint32_t column(size_t k) const {
+            return column_ids[k];
+        }
+
+        // Whether every column id in rows [start, end) is inside the
+        // vocabulary. Anything that indexes per-column buffers with the
+        // stored ids must check the rows it reads first.
+        bool valid_rows(size_t start, size_t end) const {
+            if (start >= end) {
+                return true;
+            }
+            for (size_t k = pointers[start]; k < pointers[end]; ++k) {
+                if (column_ids[k] >= header.num_columns) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        double value(size_t k) const {
+            if (header.value_type == CSR_VALUES_UINT32) {
+                return reinterpret_cast<const uint32_t*>(raw_values)[k];
+            }
+            return reinterpret_cast<const float*>(raw_values)[k];
+        }
+
+        // Copy rows [start, end) into an in-memory matrix. If columns is
+        // non-empty it maps every store column to a new column id, or -1 to
+        // drop it.
+        CSRMatrix slice(size_t start,
+                        size_t end,
+                        const std::vector<int>& columns,
+                        int num_columns) const {
+            CSRMatrix out;
+            out.num_columns = num_columns;
+            for (size_t i = start; i < end; ++i) {
+                append_row(i, columns, out);
+            }
+            return out;
+        }
+
+        void append_row(size_t i,
+                        const std::vector<int>& columns,
+                        CSRMatrix& out) const {
+            for (size_t k = pointers[i]; k < pointers[i + 1]; ++k) {
+                int column = column_ids[k];
+                if (!columns.empty()) {
+                    column = columns[column];
+                    if (column < 0) {
+                        continue;
+                    }
+                }
+                out.append(column, value(k));
+            }
+            out.end_row();
+        }
+
+    private:
+        CSRStoreHeader header;
+        MappedFile row_file;
+        MappedFile column_file;
+        MappedFile value_file;
+        const uint64_t* pointers;
+        const uint32_t* column_ids;
+        const char* raw_values;
+    };
+
+}
+
+#endif
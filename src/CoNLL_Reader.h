@@ -0,0 +1,126 @@
+#ifndef SPEEDREADER_CONLL_READER_H
+#define SPEEDREADER_CONLL_READER_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "Tokenizer.h"
+#include "Vocabulary.h"
+
+namespace mjd {
+
+    // The token columns corenlp() keeps from CoreNLP's CoNLL output, whose
+    // tab separated lines are "index word lemma POS NER head relation", with
+    // a blank line after every sentence.
+    const int CONLL_WORD = 0;
+    const int CONLL_LEMMA = 1;
+    const int CONLL_POS = 2;
+    const int CONLL_NER = 3;
+    const int CONLL_COLUMNS = 4;
+
+    // Columnar token table for a run of documents. Each column holds ids
+    // into a vocabulary shared by all columns (-1 where a line has too few
+    // fields), and the tokens of document d are offsets[d] ... offsets[d + 1]
+    // - 1. Sentences are numbered from one within each document.
+    struct TokenColumns {
+        std::vector<int> columns[CONLL_COLUMNS];
+        std::vector<int> sentence;
+        std::vector<size_t> offsets;
+
+        TokenColumns() : offsets(1, 0) {}
+
+        size_t size() const {
+            return sentence.size();
+        }
+    };
+
+    // Appends the tokens of one CoNLL document to table, interning their
+    // strings into vocabulary. As corenlp() always has, every empty line
+    // starts a new sentence and every other line is a token.
+    inline void parse_conll_document(const char* data,
+                                     size_t length,
+                                     Vocabulary& vocabulary,
+                                     TokenColumns& table) {
+        int sentence = 1;
+        std::string field;
+        size_t p = 0;
+        while (p < length) {
+            size_t end = p;
+            while (end < length && data[end] != '\n') {
+                ++end;
+            }
+            size_t line_end = end;
+            if (line_end > p && data[line_end - 1] == '\r') {
+                --line_end;
+            }
+            if (line_end == p) {
+                sentence += 1;
+            } else {
+                // skip the index, then take the next four fields.
+                size_t f = p;
+                while (f < line_end && data[f] != '\t') {
+                    ++f;
+                }
+                for (int c = 0; c < CONLL_COLUMNS; ++c) {
+                    if (f >= line_end) {
+                        table.columns[c].push_back(-1);
+                        continue;
+                    }
+                    size_t start = f + 1;
+                    f = start;
+                    while (f < line_end && data[f] != '\t') {
+                        ++f;
+                    }
+                    field.assign(data + start, f - start);
+                    table.columns[c].push_back(vocabulary.intern(field));
+                }
+                table.sentence.push_back(sentence);
+            }
+            p = end + 1;
+        }
+        table.offsets.push_back(table.size());
+    }
+
+    // Whether a word matches "[[:punct:]]+" or "[[:digit:]]+" somewhere, as
+    // grepl() does in a UTF-8 locale: ASCII punctuation plus any non-ASCII
+    // character that is neither a letter nor a space, and ASCII digits.
+    inline bool has_punctuation(const std::string& word) {
+        const unsigned char* text =
+            reinterpret_cast<const unsigned char*>(word.data());
+        size_t i = 0;
+        while (i < word.size()) {
+            unsigned char c = text[i];
+            if (c < 0x80) {
+                if ((c >= 0x21 && c <= 0x2F) || (c >= 0x3A && c <= 0x40) ||
+                    (c >= 0x5B && c <= 0x60) || (c >= 0x7B && c <= 0x7E)) {
+                    return true;
+                }
+                ++i;
+                continue;
+            }
+            unsigned int cp = 0;
+            int n = decode_utf8(text, word.size(), i, cp);
+            if (n == 0) {
+                ++i;
+                continue;
+            }
+            if (!is_unicode_letter(cp) && !is_unicode_space(cp)) {
+                return true;
+            }
+            i += n;
+        }
+        return false;
+    }
+
+    inline bool has_digit(const std::string& word) {
+        for (size_t i = 0; i < word.size(); ++i) {
+            if (word[i] >= '0' && word[i] <= '9') {
+                return true;
+            }
+        }
+        return false;
+    }
+
+}
+
+#endif
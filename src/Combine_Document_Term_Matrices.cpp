@@ -1,62 +1,118 @@
+// [[Rcpp::plugins(cpp11)]]
 #include <RcppArmadillo.h>
+#include <string>
+#include "Matrix_Merge.h"
+#include "Parallel.h"
 //[[Rcpp::depends(RcppArmadillo)]]
 using namespace Rcpp;
 
+namespace mjd {
+    CharacterVector utf8_character_vector(const std::vector<std::string>& v);
+}
+
+// Each entry of document_term_matrix_list is a list(i, j, v, nrow) of one
+// based triplets. Vocabularies are unified through a hash table, every
+// corpus is converted to CSR with remapped columns in parallel, and the rows
+// are then streamed into a single set of triplets.
 // [[Rcpp::export]]
 List Combine_Document_Term_Matrices(
-    List document_word_matrix_list,
+    List document_term_matrix_list,
     List vocabularies,
-    std::vector<std::string> unique_words,
-    int number_of_corpora
+    bool sort_columns,
+    int cores
 ){
-  
-  int vocab_size = unique_words.size();
-  int ndoc = 0;
-  
-  //get the number of rows
-  for(int i = 0; i < number_of_corpora; ++i){
-    arma::mat current = document_word_matrix_list[i];
-    ndoc += current.n_rows;
+
+  int number_of_corpora = document_term_matrix_list.size();
+  std::vector<std::vector<std::string> > corpus_vocabularies(number_of_corpora);
+  std::vector<IntegerVector> i_list(number_of_corpora);
+  std::vector<IntegerVector> j_list(number_of_corpora);
+  std::vector<NumericVector> v_list(number_of_corpora);
+  std::vector<int> num_rows(number_of_corpora);
+  for(int c = 0; c < number_of_corpora; ++c){
+    List current = document_term_matrix_list[c];
+    i_list[c] = current[0];
+    j_list[c] = current[1];
+    v_list[c] = current[2];
+    num_rows[c] = current[3];
+    corpus_vocabularies[c] = Rcpp::as<std::vector<std::string> >(vocabularies[c]);
+    int vocab_size = corpus_vocabularies[c].size();
+    int num_entries = i_list[c].size();
+    for(int k = 0; k < num_entries; ++k){
+      if(i_list[c][k] < 1 || i_list[c][k] > num_rows[c] ||
+         j_list[c][k] < 1 || j_list[c][k] > vocab_size){
+        Rcpp::stop("Document term matrix " + std::to_string(c + 1) + " has an entry outside of its dimensions or vocabulary.");
+      }
+    }
   }
-  
-  arma::mat aggregate_doc_term_matrix = arma::zeros(ndoc, vocab_size);
-  
-  // calculate df/idf
-  int document_counter  = 0;
-  for(int i = 0; i < number_of_corpora; ++i){
-    Rcpp::Rcout << "Current Corpus: " << i << std::endl;
-    arma::mat current = document_word_matrix_list[i];
-    int current_docs = current.n_rows;
-    int current_vocab_size = current.n_cols;
-    std::vector<std::string> current_vocab = vocabularies[i];
-    
-    arma::vec indexes = arma::zeros(current_vocab_size);
-    for(int k = 0; k < current_vocab_size; ++k){
-      int already = 0;
-      int counter = 0;
-      while(already == 0){
-        if(current_vocab[k] == unique_words[counter]){
-          indexes[k] = counter;
-          already = 1;
-        }
-        counter +=1;
+
+  mjd::Vocabulary unique_words;
+  std::vector<std::vector<int> > remaps =
+    mjd::unify_vocabularies(corpus_vocabularies, unique_words);
+  int vocab_size = unique_words.size();
+  Rcpp::Rcout << "Combined vocabulary size: " << vocab_size << std::endl;
+
+  // only the R vectors' memory is touched from worker threads.
+  std::vector<mjd::CSRMatrix> blocks(number_of_corpora);
+  mjd::parallel_for(number_of_corpora, cores, [&](int start, int end, int t) {
+    std::vector<int> position(vocab_size, -1);
+    for(int c = start; c < end; ++c){
+      blocks[c] = mjd::triplets_to_csr(i_list[c].begin(),
+                                       j_list[c].begin(),
+                                       v_list[c].begin(),
+                                       i_list[c].size(),
+                                       num_rows[c],
+                                       remaps[c],
+                                       vocab_size,
+                                       position);
+    }
+  });
+
+  // order columns from most to least frequent.
+  std::vector<int> ordering = mjd::frequency_order(
+    mjd::column_sums(blocks, vocab_size));
+  mjd::parallel_for(number_of_corpora, cores, [&](int start, int end, int t) {
+    for(int c = start; c < end; ++c){
+      blocks[c].remap_columns(ordering, vocab_size);
+      if(sort_columns){
+        mjd::sort_row_columns(blocks[c]);
       }
     }
-    
-    
-    for(int j = 0; j < current_docs; ++j){
-      for(int k = 0; k < current_vocab_size; ++k){
-        aggregate_doc_term_matrix(document_counter,indexes[k]) += current(j,k);
+  });
+  std::vector<std::string> ordered_words(vocab_size);
+  for(int k = 0; k < vocab_size; ++k){
+    ordered_words[ordering[k]] = unique_words.term(k);
+  }
+
+  size_t entries = 0;
+  int ndoc = 0;
+  for(int c = 0; c < number_of_corpora; ++c){
+    entries += blocks[c].num_entries();
+    ndoc += blocks[c].num_rows();
+  }
+  IntegerVector i(entries);
+  IntegerVector j(entries);
+  NumericVector v(entries);
+  size_t k = 0;
+  int row_offset = 0;
+  for(int c = 0; c < number_of_corpora; ++c){
+    mjd::CSRMatrix& block = blocks[c];
+    for(int row = 0; row < block.num_rows(); ++row){
+      for(size_t e = block.row_pointers[row];
+          e < block.row_pointers[row + 1]; ++e, ++k){
+        i[k] = row_offset + row + 1;
+        j[k] = block.columns[e] + 1;
+        v[k] = block.values[e];
       }
-      document_counter += 1;
     }
-  } 
-  
-  
-  List return_list(2);
-  return_list[0] = aggregate_doc_term_matrix;
-  return_list[1] = unique_words;
+    row_offset += block.num_rows();
+    block = mjd::CSRMatrix();
+  }
+
+  List return_list(5);
+  return_list[0] = i;
+  return_list[1] = j;
+  return_list[2] = v;
+  return_list[3] = mjd::utf8_character_vector(ordered_words);
+  return_list[4] = ndoc;
   return return_list;
 }
-
-
@@ -0,0 +1,345 @@
+// [[Rcpp::plugins(cpp11)]]
+#include <RcppArmadillo.h>
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include "Corpus.h"
+#include "Dice_Sweep.h"
+#include "Parallel.h"
+#include "Telemetry.h"
+//[[Rcpp::depends(RcppArmadillo)]]
+using namespace Rcpp;
+
+namespace mjd {
+    CharacterVector utf8_character_vector(const std::vector<std::string>& v);
+    arma::vec calculate_metrics(arma::vec which_a_in_b,
+                                arma::vec which_b_in_a,
+                                int ngram_size);
+    List dice_coefficient_matrices(const std::vector<DiceCounts>& counts,
+                                   int number_of_sizes);
+
+    // The corpus behind an external pointer made by Create_Corpus(). Pointers
+    // do not survive saving and reloading a session, so check for that.
+    Corpus& corpus_reference(SEXP pointer) {
+        if (TYPEOF(pointer) != EXTPTRSXP) {
+            Rcpp::stop("Expected a corpus created by create_corpus().");
+        }
+        XPtr<Corpus> corpus(pointer);
+        if (corpus.get() == NULL) {
+            Rcpp::stop("This corpus is no longer in memory (it may have been saved and reloaded). Create it again with create_corpus().");
+        }
+        return *corpus;
+    }
+
+    // Tokenized documents from R, copied once so they can be interned off
+    // the main thread.
+    void append_documents(Corpus& corpus, List documents, int cores) {
+        int num_documents = documents.size();
+        std::vector<std::vector<std::string> > tokens(num_documents);
+        for (int d = 0; d < num_documents; ++d) {
+            tokens[d] = Rcpp::as<std::vector<std::string> >(documents[d]);
+        }
+        int ranges = parallel_ranges(num_documents, cores);
+        std::vector<Vocabulary> locals(ranges);
+        std::vector<std::vector<int> > local_tokens(ranges);
+        std::vector<std::vector<size_t> > local_lengths(ranges);
+        parallel_for(num_documents, cores, [&](int start, int end, int t) {
+            intern_documents(tokens, start, end, locals[t],
+                             local_tokens[t], local_lengths[t]);
+        });
+        corpus.append(locals, local_tokens, local_lengths);
+        telemetry().counter("Corpus.documents") += num_documents;
+    }
+
+    void check_document_index(const Corpus& corpus, int d) {
+        if (d < 1 || d > corpus.num_documents()) {
+            Rcpp::stop("Document index out of range of the corpus.");
+        }
+    }
+}
+
+// Interns a list of tokenized documents into a native corpus held by an
+// external pointer, so later kernels can use its term ids without
+// converting the strings again. If frequency_ranked, term ids are then
+// renumbered by descending frequency.
+// [[Rcpp::export]]
+SEXP Create_Corpus(List documents,
+                   int cores,
+                   bool frequency_ranked){
+    XPtr<mjd::Corpus> corpus(new mjd::Corpus(), true);
+    mjd::append_documents(*corpus, documents, cores);
+    if (frequency_ranked) {
+        mjd::PhaseTimer ranking("Create_Corpus.ranking");
+        corpus->rank_by_frequency();
+    }
+    return corpus;
+}
+
+// Returns the number of documents, tokens and distinct terms in a corpus,
+// and whether its term ids are ranked by frequency.
+// [[Rcpp::export]]
+List Corpus_Info(SEXP corpus){
+    mjd::Corpus& current = mjd::corpus_reference(corpus);
+    List to_return(4);
+    to_return[0] = current.num_documents();
+    to_return[1] = double(current.num_tokens());
+    to_return[2] = current.vocabulary().size();
+    to_return[3] = current.frequency_ranked();
+    return to_return;
+}
+
+// Returns the terms of a corpus in the order they were first seen, whatever
+// ids they have been given.
+// [[Rcpp::export]]
+CharacterVector Corpus_Vocabulary(SEXP corpus){
+    mjd::Corpus& current = mjd::corpus_reference(corpus);
+    const mjd::Vocabulary& vocabulary = current.vocabulary();
+    std::vector<std::string> terms(vocabulary.size());
+    for (int id = 0; id < vocabulary.size(); ++id) {
+        terms[current.first_seen(id)] = vocabulary.term(id);
+    }
+    return mjd::utf8_character_vector(terms);
+}
+
+// Returns the one based documents of a corpus as character vectors.
+// [[Rcpp::export]]
+List Corpus_Documents(SEXP corpus,
+                      std::vector<int> documents){
+    mjd::Corpus& current = mjd::corpus_reference(corpus);
+    List to_return(documents.size());
+    std::vector<std::string> tokens;
+    for (size_t k = 0; k < documents.size(); ++k) {
+        mjd::check_document_index(current, documents[k]);
+        int d = documents[k] - 1;
+        const int* ids = current.document(d);
+        tokens.resize(current.length(d));
+        for (size_t i = 0; i < tokens.size(); ++i) {
+            tokens[i] = current.vocabulary().term(ids[i]);
+        }
+        to_return[k] = mjd::utf8_character_vector(tokens);
+    }
+    return to_return;
+}
+
+// Counts every term in a corpus, in the same form as Count_Words(): the
+// number of distinct terms, the terms in the order they were first seen,
+// and their counts. Each thread counts a run of documents.
+// [[Rcpp::export]]
+List Corpus_Count_Words(SEXP corpus,
+                        int cores){
+    mjd::Corpus& current = mjd::corpus_reference(corpus);
+    mjd::PhaseTimer counting("Corpus_Count_Words.counting");
+    int num_terms = current.vocabulary().size();
+    int ranges = mjd::parallel_ranges(current.num_documents(), cores);
+    std::vector<std::vector<double> > partial(ranges);
+    mjd::parallel_for(current.num_documents(), cores, [&](int start, int end, int t) {
+        partial[t].assign(num_terms, 0);
+        for (int d = start; d < end; ++d) {
+            const int* ids = current.document(d);
+            for (size_t i = 0; i < current.length(d); ++i) {
+                partial[t][ids[i]] += 1;
+            }
+        }
+    });
+    // terms and counts go back in first-seen order, as in Corpus_Vocabulary(),
+    // so ranking a corpus by frequency does not change the result.
+    std::vector<std::string> terms(num_terms);
+    NumericVector counts(num_terms);
+    for (int id = 0; id < num_terms; ++id) {
+        int position = current.first_seen(id);
+        terms[position] = current.vocabulary().term(id);
+        for (int t = 0; t < ranges; ++t) {
+            counts[position] += partial[t][id];
+        }
+    }
+
+    List to_return(3);
+    to_return[0] = num_terms;
+    to_return[1] = mjd::utf8_character_vector(terms);
+    to_return[2] = counts;
+    return to_return;
+}
+
+// Sparse document term matrix of a corpus against a vocabulary, as one
+// based (i, j, v) triplets ordered by document and then column. Terms not
+// in the vocabulary are dropped. Documents are counted in parallel.
+// [[Rcpp::export]]
+List Corpus_Document_Term_Matrix(SEXP corpus,
+                                 std::vector<std::string> vocabulary,
+                                 int cores){
+    mjd::Corpus& current = mjd::corpus_reference(corpus);
+    mjd::PhaseTimer counting("Corpus_Document_Term_Matrix.counting");
+
+    // the column of each corpus term, looked up once.
+    mjd::Vocabulary columns(vocabulary);
+    int num_terms = current.vocabulary().size();
+    std::vector<int> column(num_terms);
+    for (int id = 0; id < num_terms; ++id) {
+        column[id] = columns.find(current.vocabulary().term(id));
+    }
+
+    int num_documents = current.num_documents();
+    int ranges = mjd::parallel_ranges(num_documents, cores);
+    std::vector<std::vector<int> > rows(ranges);
+    std::vector<std::vector<int> > cols(ranges);
+    std::vector<std::vector<double> > values(ranges);
+    mjd::parallel_for(num_documents, cores, [&](int start, int end, int t) {
+        std::vector<int> present;
+        for (int d = start; d < end; ++d) {
+            const int* ids = current.document(d);
+            present.clear();
+            for (size_t i = 0; i < current.length(d); ++i) {
+                if (column[ids[i]] >= 0) {
+                    present.push_back(column[ids[i]]);
+                }
+            }
+            std::sort(present.begin(), present.end());
+            for (size_t i = 0; i < present.size(); ) {
+                size_t next = i;
+                while (next < present.size() && present[next] == present[i]) {
+                    ++next;
+                }
+                rows[t].push_back(d + 1);
+                cols[t].push_back(present[i] + 1);
+                values[t].push_back(next - i);
+                i = next;
+            }
+        }
+    });
+
+    size_t num_entries = 0;
+    for (int t = 0; t < ranges; ++t) {
+        num_entries += rows[t].size();
+    }
+    IntegerVector i(num_entries);
+    IntegerVector j(num_entries);
+    NumericVector v(num_entries);
+    size_t k = 0;
+    for (int t = 0; t < ranges; ++t) {
+        for (size_t e = 0; e < rows[t].size(); ++e, ++k) {
+            i[k] = rows[t][e];
+            j[k] = cols[t][e];
+            v[k] = values[t][e];
+        }
+    }
+
+    List to_return(3);
+    to_return[0] = i;
+    to_return[1] = j;
+    to_return[2] = v;
+    return to_return;
+}
+
+// The 37 sequence matching metrics of
+// Efficient_Block_Sequential_String_Set_Hash_Comparison() for zero based
+// pairs of corpus documents (comparison_inds), using the same n-grams but
+// hashing term ids rather than strings. N-grams are built for the documents
+// in use in parallel, and match masks for each chunk of comparisons are
+// found in parallel before their metrics are computed.
+// [[Rcpp::export]]
+arma::mat Corpus_Sequence_Comparison(SEXP corpus,
+                                     arma::mat comparison_inds,
+                                     int ngram_length,
+                                     int cores){
+    mjd::Corpus& current = mjd::corpus_reference(corpus);
+    int num_documents = current.num_documents();
+    int num_comparisons = comparison_inds.n_rows;
+    std::vector<int> first(num_comparisons);
+    std::vector<int> second(num_comparisons);
+    std::vector<char> used(num_documents, 0);
+    for (int c = 0; c < num_comparisons; ++c) {
+        first[c] = comparison_inds(c, 0);
+        second[c] = comparison_inds(c, 1);
+        if (first[c] < 0 || first[c] >= num_documents ||
+            second[c] < 0 || second[c] >= num_documents) {
+            Rcpp::stop("Comparison index out of range of the corpus.");
+        }
+        used[first[c]] = 1;
+        used[second[c]] = 1;
+    }
+
+    mjd::PhaseTimer hashing("Corpus_Sequence_Comparison.hashing");
+    std::vector<std::vector<std::string> > ngrams(num_documents);
+    std::vector<std::unordered_set<std::string> > dictionaries(num_documents);
+    mjd::parallel_for(num_documents, cores, [&](int start, int end, int t) {
+        for (int d = start; d < end; ++d) {
+            if (used[d]) {
+                mjd::sequence_ngram_keys(current.document(d), current.length(d),
+                                         ngram_length, ngrams[d]);
+                dictionaries[d].insert(ngrams[d].begin(), ngrams[d].end());
+            }
+        }
+    });
+    hashing.stop();
+
+    mjd::PhaseTimer comparing("Corpus_Sequence_Comparison.comparing");
+    mjd::Progress progress("Current Comparison", num_comparisons);
+    arma::mat comparison_metrics = arma::zeros(num_comparisons, 37);
+    const int chunk = 4096;
+    std::vector<std::vector<double> > a_in_b(chunk);
+    std::vector<std::vector<double> > b_in_a(chunk);
+    for (int begin = 0; begin < num_comparisons; begin += chunk) {
+        int size = std::min(chunk, num_comparisons - begin);
+        mjd::parallel_for(size, cores, [&](int start, int end, int t) {
+            for (int k = start; k < end; ++k) {
+                int c = begin + k;
+                mjd::ngram_matches(ngrams[first[c]], dictionaries[second[c]],
+                                   a_in_b[k]);
+                mjd::ngram_matches(ngrams[second[c]], dictionaries[first[c]],
+                                   b_in_a[k]);
+            }
+        });
+        for (int k = 0; k < size; ++k) {
+            arma::vec metrics = mjd::calculate_metrics(
+                arma::vec(a_in_b[k]), arma::vec(b_in_a[k]), ngram_length);
+            comparison_metrics.row(begin + k) = arma::trans(metrics);
+        }
+        progress.update(begin + size);
+    }
+    progress.finish();
+    mjd::telemetry().counter("Corpus_Sequence_Comparison.comparisons") += num_comparisons;
+    return comparison_metrics;
+}
+
+// Dice coefficients for every n-gram size between one based corpus
+// documents documents_a[k] and documents_b[k], as Multi_Dice_Coefficients()
+// computes them. Each pair's term ids are renumbered densely before the
+// suffix array sweep, and pairs are spread over threads.
+// [[Rcpp::export]]
+List Corpus_Dice_Coefficients(SEXP corpus,
+                              std::vector<int> documents_a,
+                              std::vector<int> documents_b,
+                              std::vector<int> ngram_sizes,
+                              int cores){
+    mjd::Corpus& current = mjd::corpus_reference(corpus);
+    int number_of_pairs = documents_a.size();
+    if (documents_b.size() != size_t(number_of_pairs)) {
+        Rcpp::stop("There must be the same number of documents in each list.");
+    }
+    for (int k = 0; k < number_of_pairs; ++k) {
+        mjd::check_document_index(current, documents_a[k]);
+        mjd::check_document_index(current, documents_b[k]);
+    }
+
+    std::vector<mjd::DiceCounts> counts(number_of_pairs);
+    mjd::parallel_for(number_of_pairs, cores, [&](int start, int end, int t) {
+        std::unordered_map<int, int> dense;
+        for (int k = start; k < end; ++k) {
+            dense.clear();
+            int da = documents_a[k] - 1;
+            int db = documents_b[k] - 1;
+            std::vector<int> a(current.length(da));
+            std::vector<int> b(current.length(db));
+            for (size_t i = 0; i < a.size(); ++i) {
+                a[i] = dense.emplace(current.document(da)[i], dense.size()).first->second;
+            }
+            for (size_t i = 0; i < b.size(); ++i) {
+                b[i] = dense.emplace(current.document(db)[i], dense.size()).first->second;
+            }
+            counts[k] = mjd::multi_dice_counts(a, b, dense.size(), ngram_sizes);
+        }
+    });
+
+    return mjd::dice_coefficient_matrices(counts, ngram_sizes.size());
+}
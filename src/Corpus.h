@@ -0,0 +1,153 @@
+#ifndef SPEEDREADER_CORPUS_H
+#define SPEEDREADER_CORPUS_H
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <unordered_set>
+#include <cstddef>
+#include "Vocabulary.h"
+
+namespace mjd {
+
+    // Tokens interned once into a shared string pool, for kernels that are
+    // run over the same documents many times. Document d is the run of term
+    // ids tokens[offsets[d]] ... tokens[offsets[d + 1] - 1]. Ids are assigned
+    // in the order terms are first seen, document by document, unless the
+    // corpus has been ranked by frequency (see rank_by_frequency()).
+    class Corpus {
+    public:
+        Corpus() : offsets(1, 0), ranked(false) {}
+
+        int num_documents() const {
+            return offsets.size() - 1;
+        }
+
+        size_t num_tokens() const {
+            return tokens.size();
+        }
+
+        const int* document(int d) const {
+            return tokens.data() + offsets[d];
+        }
+
+        size_t length(int d) const {
+            return offsets[d + 1] - offsets[d];
+        }
+
+        const Vocabulary& vocabulary() const {
+            return terms;
+        }
+
+        bool frequency_ranked() const {
+            return ranked;
+        }
+
+        // The position of a term in first-seen order, which is its id unless
+        // the corpus has been ranked by frequency.
+        int first_seen(int id) const {
+            return id < int(seen.size()) ? seen[id] : id;
+        }
+
+        // Renumbers terms by descending corpus frequency, so the head of the
+        // Zipf distribution takes the lowest ids and kernels indexing
+        // per-term arrays by id mostly touch the first few cache lines.
+        // Terms added later are given ids after every ranked term.
+        void rank_by_frequency() {
+            std::vector<double> counts(terms.size(), 0);
+            for (size_t k = 0; k < tokens.size(); ++k) {
+                counts[tokens[k]] += 1;
+            }
+            std::vector<int> new_ids = frequency_ranking(counts);
+            for (size_t k = 0; k < tokens.size(); ++k) {
+                tokens[k] = new_ids[tokens[k]];
+            }
+            std::vector<int> renumbered_seen(terms.size());
+            for (size_t k = 0; k < new_ids.size(); ++k) {
+                renumbered_seen[new_ids[k]] = first_seen(k);
+            }
+            seen.swap(renumbered_seen);
+            terms.renumber(new_ids);
+            ranked = true;
+        }
+
+        // Appends documents tokenized against local vocabularies (one per
+        // thread, in document order), so the ids they are given match a
+        // sequential pass over the documents.
+        void append(const std::vector<Vocabulary>& locals,
+                    const std::vector<std::vector<int> >& local_tokens,
+                    const std::vector<std::vector<size_t> >& local_lengths) {
+            std::vector<std::vector<int> > remaps = terms.merge(locals);
+            for (size_t t = 0; t < locals.size(); ++t) {
+                size_t k = 0;
+                for (size_t d = 0; d < local_lengths[t].size(); ++d) {
+                    for (size_t i = 0; i < local_lengths[t][d]; ++i, ++k) {
+                        tokens.push_back(remaps[t][local_tokens[t][k]]);
+                    }
+                    offsets.push_back(tokens.size());
+                }
+            }
+        }
+
+    private:
+        Vocabulary terms;
+        std::vector<int> seen;
+        std::vector<int> tokens;
+        std::vector<size_t> offsets;
+        bool ranked;
+    };
+
+    // Interns a run of tokenized documents into a local vocabulary, for
+    // Corpus::append().
+    inline void intern_documents(const std::vector<std::vector<std::string> >& documents,
+                                 int start,
+                                 int end,
+                                 Vocabulary& vocabulary,
+                                 std::vector<int>& tokens,
+                                 std::vector<size_t>& lengths) {
+        for (int d = start; d < end; ++d) {
+            for (size_t i = 0; i < documents[d].size(); ++i) {
+                tokens.push_back(vocabulary.intern(documents[d][i]));
+            }
+            lengths.push_back(documents[d].size());
+        }
+    }
+
+    // The n-grams Efficient_Block_Sequential_String_Set_Hash_Comparison()
+    // compares, as keys holding the bytes of their term ids: for an n-gram
+    // length L > 1, the (L - 1) token windows starting at the first n - L + 1
+    // positions (or at every position of a document with no more than L - 1
+    // tokens, clipped at its end), and unigrams otherwise.
+    inline void sequence_ngram_keys(const int* document,
+                                    size_t length,
+                                    int ngram_length,
+                                    std::vector<std::string>& keys) {
+        size_t count = length;
+        size_t width = 1;
+        if (ngram_length > 1) {
+            if (length > size_t(ngram_length - 1)) {
+                count = length - (ngram_length - 1);
+            }
+            width = std::max(size_t(1), std::min(size_t(ngram_length - 1), count));
+        }
+        keys.resize(count);
+        for (size_t k = 0; k < count; ++k) {
+            size_t end = std::min(length, k + width);
+            keys[k].assign(reinterpret_cast<const char*>(document + k),
+                           (end - k) * sizeof(int));
+        }
+    }
+
+    // Which of the n-grams in a appear anywhere in b (as a 0/1 mask).
+    inline void ngram_matches(const std::vector<std::string>& a,
+                              const std::unordered_set<std::string>& b,
+                              std::vector<double>& mask) {
+        mask.resize(a.size());
+        for (size_t k = 0; k < a.size(); ++k) {
+            mask[k] = b.count(a[k]) > 0 ? 1 : 0;
+        }
+    }
+
+}
+
+#endif
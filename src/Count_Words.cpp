@@ -1,5 +1,7 @@
 #include <RcppArmadillo.h>
 #include <string>
+#include <unordered_map>
+#include "Telemetry.h"
 //[[Rcpp::depends(RcppArmadillo)]]
 using namespace Rcpp;
 
@@ -22,8 +24,16 @@ List Count_Words(
   arma::vec unique_word_counts = arma::zeros(max_vocab_size);
   std::vector<std::string> unique_words(max_vocab_size);
 
+  // words are only ever added while there is room for them.
+  const std::string too_small = "You have specified a maximum_vocabulary_size that is too small. "
+      "Considder increasing it or setting it to -1, "
+      "in which case the total number of tokens in all documents will be used.";
+
   // if we are adding to an existing vocabulary, then populate the vector
   if(add_to_vocabulary == 1){
+      if(existing_vocabulary_size > max_vocab_size){
+          Rcpp::stop(too_small);
+      }
       for(int j = 0; j < existing_vocabulary_size; ++j){
           //break referencing
           std::string temp = existing_vocabulary[j];
@@ -33,44 +43,45 @@ List Count_Words(
       }
       total_unique_words = existing_vocabulary_size;
   }
+  std::unordered_map<std::string, int> index;
+  for(int j = 0; j < total_unique_words; ++j){
+      index.emplace(unique_words[j], j);
+  }
 
+  mjd::PhaseTimer counting("Count_Words.counting");
+  mjd::Progress progress("Current Document", number_of_documents);
   for(int n = 0; n < number_of_documents; ++n){
     if(print_counter == 1){
-        Rcpp::Rcout << "Current Document: " << n << std::endl;
+        progress.update(n);
     }
     int length = Document_Lengths[n];
     if(length > 0){
       std::vector<std::string> current = Document_Words[n];
       arma::vec current_counts = Document_Word_Counts[n];
       for(int i = 0; i < length; ++i){
-        int already = 0;
-        int counter = 0;
-        while(already == 0){
-          if(counter == total_unique_words){
-            unique_words[counter] = current[i];
-            if(using_wordcounts == 1){
-                unique_word_counts[counter] += current_counts[i];
-            }else{
-                unique_word_counts[counter] += 1;
-            }
-            total_unique_words += 1;
-            already = 1;
-          }else{
-            if(unique_words[counter] == current[i]){
-                if(using_wordcounts == 1){
-                    unique_word_counts[counter] += current_counts[i];
-                }else{
-                    unique_word_counts[counter] += 1;
-                }
-              already  = 1;
-            }
+        // the index keeps counting linear in the number of tokens.
+        std::pair<std::unordered_map<std::string, int>::iterator, bool> found =
+            index.emplace(current[i], total_unique_words);
+        int position = found.first->second;
+        if(found.second){
+          if(position >= max_vocab_size){
+              Rcpp::stop(too_small);
           }
-          counter +=1;
+          unique_words[position] = current[i];
+          total_unique_words += 1;
+        }
+        if(using_wordcounts == 1){
+            unique_word_counts[position] += current_counts[i];
+        }else{
+            unique_word_counts[position] += 1;
         }
       }
     }
   }
 
+  progress.finish();
+  mjd::telemetry().counter("Count_Words.documents") += number_of_documents;
+
   arma::vec word_counts = arma::zeros(total_unique_words);
   std::vector<std::string> words(total_unique_words);
   for(int i = 0; i < total_unique_words; ++i){
@@ -0,0 +1,135 @@
+#ifndef SPEEDREADER_DENSE_TFIDF_H
+#define SPEEDREADER_DENSE_TFIDF_H
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include "Parallel.h"
+
+namespace mjd {
+
+    // Column major dense document x term kernels. Every loop walks one column
+    // at a time down contiguous memory, without branches in the inner loop,
+    // so the compiler can vectorize it. Columns are handed to threads in
+    // blocks of DENSE_COLUMN_BLOCK. The kernels are templated on the value
+    // type so single precision matrices can be used from C++ at half the
+    // memory; R always passes doubles.
+    const size_t DENSE_COLUMN_BLOCK = 64;
+
+    // Calls f(first_column, last_column, thread) for contiguous runs of
+    // whole column blocks.
+    template <typename F>
+    void parallel_column_blocks(size_t cols, int cores, F f) {
+        int blocks = (cols + DENSE_COLUMN_BLOCK - 1) / DENSE_COLUMN_BLOCK;
+        parallel_for(blocks, cores, [&](int start, int end, int t) {
+            size_t first = start * DENSE_COLUMN_BLOCK;
+            size_t last = std::min(cols, end * DENSE_COLUMN_BLOCK);
+            f(first, last, t);
+        });
+    }
+
+    template <typename T>
+    inline double count_positive(const T* x, size_t n) {
+        size_t count = 0;
+        for (size_t i = 0; i < n; ++i) {
+            count += x[i] > T(0);
+        }
+        return count;
+    }
+
+    // Number of documents each term appears in.
+    template <typename T>
+    void dense_document_frequency(const T* data,
+                                  size_t rows,
+                                  size_t cols,
+                                  int cores,
+                                  double* document_frequency) {
+        parallel_column_blocks(cols, cores, [&](size_t first, size_t last, int t) {
+            for (size_t j = first; j < last; ++j) {
+                document_frequency[j] = count_positive(data + j * rows, rows);
+            }
+        });
+    }
+
+    // Document frequencies, column sums and row sums in one pass. Each thread
+    // accumulates row sums over its own columns, and these are added in
+    // thread order at the end.
+    template <typename T>
+    void dense_column_statistics(const T* data,
+                                 size_t rows,
+                                 size_t cols,
+                                 int cores,
+                                 double* document_frequency,
+                                 double* column_sums,
+                                 double* row_sums) {
+        int blocks = (cols + DENSE_COLUMN_BLOCK - 1) / DENSE_COLUMN_BLOCK;
+        std::vector<std::vector<double> > partial(parallel_ranges(blocks, cores));
+        parallel_column_blocks(cols, cores, [&](size_t first, size_t last, int t) {
+            std::vector<double>& sums = partial[t];
+            sums.assign(rows, 0);
+            for (size_t j = first; j < last; ++j) {
+                const T* column = data + j * rows;
+                double total = 0;
+                for (size_t i = 0; i < rows; ++i) {
+                    total += column[i];
+                    sums[i] += column[i];
+                }
+                document_frequency[j] = count_positive(column, rows);
+                column_sums[j] = total;
+            }
+        });
+        for (size_t i = 0; i < rows; ++i) {
+            row_sums[i] = 0;
+        }
+        for (size_t t = 0; t < partial.size(); ++t) {
+            for (size_t i = 0; i < partial[t].size(); ++i) {
+                row_sums[i] += partial[t][i];
+            }
+        }
+    }
+
+    // tfidf(i, j) = (x(i, j) / row_sums[i]) * log(rows / document_frequency[j])
+    // for documents with at least one token, and zero otherwise, with the
+    // idf taken once per column. term_frequency may be null if it is not
+    // needed, and tfidf may alias data to work in place.
+    template <typename T>
+    void dense_tfidf(const T* data,
+                     size_t rows,
+                     size_t cols,
+                     const double* row_sums,
+                     const double* document_frequency,
+                     int cores,
+                     T* tfidf,
+                     T* term_frequency) {
+        std::vector<char> has_tokens(rows);
+        std::vector<double> divisor(rows);
+        for (size_t i = 0; i < rows; ++i) {
+            has_tokens[i] = row_sums[i] > 0;
+            divisor[i] = row_sums[i] > 0 ? row_sums[i] : 1;
+        }
+        parallel_column_blocks(cols, cores, [&](size_t first, size_t last, int t) {
+            for (size_t j = first; j < last; ++j) {
+                double idf = std::log(double(rows) / document_frequency[j]);
+                const T* column = data + j * rows;
+                T* out = tfidf + j * rows;
+                if (term_frequency != 0) {
+                    T* tf_out = term_frequency + j * rows;
+                    for (size_t i = 0; i < rows; ++i) {
+                        double tf = column[i] / divisor[i];
+                        tf_out[i] = has_tokens[i] ? tf : 0;
+                        out[i] = has_tokens[i] ? idf * tf : 0;
+                    }
+                } else {
+                    for (size_t i = 0; i < rows; ++i) {
+                        double tf = column[i] / divisor[i];
+                        out[i] = has_tokens[i] ? idf * tf : 0;
+                    }
+                }
+            }
+        });
+    }
+
+}
+
+#endif
@@ -0,0 +1,264 @@
+#ifndef SPEEDREADER_DICE_SWEEP_H
+#define SPEEDREADER_DICE_SWEEP_H
+
+#include <vector>
+#include <algorithm>
+
+namespace mjd {
+
+    // Suffix array of a sequence of non-negative integer ids, built by prefix
+    // doubling.
+    inline std::vector<int> suffix_array(const std::vector<int>& s) {
+        int n = s.size();
+        std::vector<int> sa(n);
+        std::vector<int> rank(s.begin(), s.end());
+        std::vector<int> next_rank(n);
+        for (int i = 0; i < n; ++i) {
+            sa[i] = i;
+        }
+        for (int k = 1; n > 1; k <<= 1) {
+            auto key = [&rank, k, n](int i) {
+                return std::make_pair(rank[i], i + k < n ? rank[i + k] : -1);
+            };
+            std::sort(sa.begin(), sa.end(), [&key](int a, int b) {
+                return key(a) < key(b);
+            });
+            next_rank[sa[0]] = 0;
+            for (int i = 1; i < n; ++i) {
+                next_rank[sa[i]] = next_rank[sa[i - 1]] +
+                    (key(sa[i - 1]) < key(sa[i]));
+            }
+            rank.swap(next_rank);
+            if (rank[sa[n - 1]] == n - 1) {
+                break;
+            }
+        }
+        return sa;
+    }
+
+    // lcp[k] is the length of the longest common prefix of the suffixes at
+    // sa[k] and sa[k + 1] (Kasai et al.).
+    inline std::vector<int> lcp_array(const std::vector<int>& s,
+                                      const std::vector<int>& sa) {
+        int n = s.size();
+        std::vector<int> rank(n);
+        for (int i = 0; i < n; ++i) {
+            rank[sa[i]] = i;
+        }
+        std::vector<int> lcp(n > 0 ? n - 1 : 0, 0);
+        int h = 0;
+        for (int i = 0; i < n; ++i) {
+            if (rank[i] == 0) {
+                h = 0;
+                continue;
+            }
+            int j = sa[rank[i] - 1];
+            while (i + h < n && j + h < n && s[i + h] == s[j + h]) {
+                ++h;
+            }
+            lcp[rank[i] - 1] = h;
+            if (h > 0) {
+                --h;
+            }
+        }
+        return lcp;
+    }
+
+    // Distinct n-gram counts for the two documents of a pair, and the number
+    // they share, indexed by n-gram size.
+    struct DiceCounts {
+        std::vector<double> ngrams_a;
+        std::vector<double> ngrams_b;
+        std::vector<double> both;
+    };
+
+    // For every window length m in 1..max_window, count the distinct m token
+    // windows of a and b that start at a position with at least m + 1 tokens
+    // remaining, and how many of those are shared. Suffixes of a, a separator
+    // and b are sorted once; two windows are equal exactly when their suffixes
+    // sit in a run of the suffix array with LCP >= m. Sweeping m downwards and
+    // merging runs with a union-find as their LCP is reached yields every
+    // length in a single pass. Entries are indexed by m (index 0 is unused).
+    inline DiceCounts window_overlap_counts(const std::vector<int>& a,
+                                            const std::vector<int>& b,
+                                            int separator,
+                                            int max_window) {
+        DiceCounts counts;
+        counts.ngrams_a.assign(max_window + 1, 0);
+        counts.ngrams_b.assign(max_window + 1, 0);
+        counts.both.assign(max_window + 1, 0);
+        if (max_window < 1) {
+            return counts;
+        }
+
+        std::vector<int> s(a.begin(), a.end());
+        s.push_back(separator);
+        s.insert(s.end(), b.begin(), b.end());
+        int n = s.size();
+        int la = a.size();
+        std::vector<int> sa = suffix_array(s);
+        std::vector<int> lcp = lcp_array(s, sa);
+
+        // bucket the merges and activations by the largest m they apply to.
+        std::vector<std::vector<int> > merges(max_window + 1);
+        std::vector<std::vector<int> > activations(max_window + 1);
+        for (int k = 0; k + 1 < n; ++k) {
+            if (lcp[k] > 0) {
+                merges[std::min(lcp[k], max_window)].push_back(k);
+            }
+        }
+        // document (0 for a, 1 for b, -1 for the separator) of each suffix.
+        std::vector<int> document(n);
+        for (int k = 0; k < n; ++k) {
+            int p = sa[k];
+            int remaining = 0;
+            if (p < la) {
+                document[k] = 0;
+                remaining = la - p;
+            } else if (p > la) {
+                document[k] = 1;
+                remaining = n - p;
+            } else {
+                document[k] = -1;
+            }
+            if (remaining > 1) {
+                activations[std::min(remaining - 1, max_window)].push_back(k);
+            }
+        }
+
+        std::vector<int> parent(n);
+        std::vector<char> has_a(n, 0);
+        std::vector<char> has_b(n, 0);
+        for (int k = 0; k < n; ++k) {
+            parent[k] = k;
+        }
+        auto find = [&parent](int x) {
+            while (parent[x] != x) {
+                parent[x] = parent[parent[x]];
+                x = parent[x];
+            }
+            return x;
+        };
+        double in_a = 0;
+        double in_b = 0;
+        double in_both = 0;
+        auto contribution = [&](int root, double sign) {
+            in_a += sign * has_a[root];
+            in_b += sign * has_b[root];
+            in_both += sign * (has_a[root] && has_b[root]);
+        };
+
+        for (int m = max_window; m >= 1; --m) {
+            for (size_t e = 0; e < merges[m].size(); ++e) {
+                int x = find(merges[m][e]);
+                int y = find(merges[m][e] + 1);
+                if (x == y) {
+                    continue;
+                }
+                contribution(x, -1);
+                contribution(y, -1);
+                parent[y] = x;
+                has_a[x] = has_a[x] || has_a[y];
+                has_b[x] = has_b[x] || has_b[y];
+                contribution(x, 1);
+            }
+            for (size_t e = 0; e < activations[m].size(); ++e) {
+                int k = activations[m][e];
+                int root = find(k);
+                contribution(root, -1);
+                if (document[k] == 0) {
+                    has_a[root] = 1;
+                } else {
+                    has_b[root] = 1;
+                }
+                contribution(root, 1);
+            }
+            counts.ngrams_a[m] = in_a;
+            counts.ngrams_b[m] = in_b;
+            counts.both[m] = in_both;
+        }
+        return counts;
+    }
+
+    // Distinct n-gram counts for each requested n-gram size, using the same
+    // n-grams Variable_Dice_Coefficients() always has: unigrams for sizes of
+    // one or less; otherwise the n - 1 token windows starting at the first
+    // L - n + 1 positions, or every unigram if the document has no more than
+    // n - 1 tokens. a and b are token ids below separator.
+    inline DiceCounts multi_dice_counts(const std::vector<int>& a,
+                                        const std::vector<int>& b,
+                                        int separator,
+                                        const std::vector<int>& ngram_sizes) {
+        int max_size = 1;
+        for (size_t k = 0; k < ngram_sizes.size(); ++k) {
+            max_size = std::max(max_size, ngram_sizes[k]);
+        }
+        DiceCounts windows = window_overlap_counts(a, b, separator,
+                                                   max_size - 1);
+
+        // distinct unigrams, and for n = 2 against a short document, the
+        // tokens available to each document's one token windows.
+        std::vector<char> seen(separator, 0);
+        double unigrams_a = 0;
+        double unigrams_b = 0;
+        double unigrams_both = 0;
+        for (size_t k = 0; k < a.size(); ++k) {
+            if (!(seen[a[k]] & 1)) {
+                seen[a[k]] |= 1;
+                unigrams_a += 1;
+            }
+        }
+        for (size_t k = 0; k < b.size(); ++k) {
+            if (!(seen[b[k]] & 2)) {
+                seen[b[k]] |= 2;
+                unigrams_b += 1;
+                unigrams_both += seen[b[k]] & 1;
+            }
+        }
+        auto shared_with_prefix = [&](const std::vector<int>& short_doc,
+                                      const std::vector<int>& long_doc) {
+            std::vector<char> in_prefix(separator, 0);
+            for (size_t k = 0; k + 1 < long_doc.size(); ++k) {
+                in_prefix[long_doc[k]] = 1;
+            }
+            double shared = 0;
+            for (size_t k = 0; k < short_doc.size(); ++k) {
+                shared += in_prefix[short_doc[k]];
+                in_prefix[short_doc[k]] = 0;
+            }
+            return shared;
+        };
+
+        DiceCounts counts;
+        int la = a.size();
+        int lb = b.size();
+        for (size_t k = 0; k < ngram_sizes.size(); ++k) {
+            int n = ngram_sizes[k];
+            if (n <= 1) {
+                counts.ngrams_a.push_back(unigrams_a);
+                counts.ngrams_b.push_back(unigrams_b);
+                counts.both.push_back(unigrams_both);
+                continue;
+            }
+            bool short_a = la <= n - 1;
+            bool short_b = lb <= n - 1;
+            counts.ngrams_a.push_back(short_a ? unigrams_a : windows.ngrams_a[n - 1]);
+            counts.ngrams_b.push_back(short_b ? unigrams_b : windows.ngrams_b[n - 1]);
+            if (!short_a && !short_b) {
+                counts.both.push_back(windows.both[n - 1]);
+            } else if (short_a && short_b) {
+                counts.both.push_back(unigrams_both);
+            } else if (n == 2) {
+                counts.both.push_back(short_a ? shared_with_prefix(a, b)
+                                              : shared_with_prefix(b, a));
+            } else {
+                // unigrams against longer windows never match.
+                counts.both.push_back(0);
+            }
+        }
+        return counts;
+    }
+
+}
+
+#endif
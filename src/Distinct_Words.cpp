@@ -0,0 +1,113 @@
+// [[Rcpp::plugins(cpp11)]]
+#include <RcppArmadillo.h>
+#include <string>
+#include "Parallel.h"
+#include "Vocabulary.h"
+//[[Rcpp::depends(RcppArmadillo)]]
+using namespace Rcpp;
+
+// For each word vector, returns a logical mask of the words to keep: those
+// that appear threshold or fewer times in every other vector. All vectors
+// are interned into one vocabulary, each vector's term counts are taken in a
+// single pass, and a term -> (number of vectors it exceeds threshold in, last
+// such vector) table then decides every word in constant time.
+// [[Rcpp::export]]
+List Distinct_Words(List word_vector_list,
+                    double threshold,
+                    int cores){
+
+    int num_vectors = word_vector_list.size();
+    std::vector<std::vector<std::string> > words(num_vectors);
+    for (int i = 0; i < num_vectors; ++i) {
+        words[i] = Rcpp::as<std::vector<std::string> >(word_vector_list[i]);
+    }
+
+    // intern into per-thread vocabularies, then merge them in thread order.
+    int ranges = mjd::parallel_ranges(num_vectors, cores);
+    std::vector<mjd::Vocabulary> local_vocabularies(ranges);
+    std::vector<std::vector<int> > ids(num_vectors);
+    std::vector<int> range_of_vector(num_vectors);
+    mjd::parallel_for(num_vectors, cores, [&](int start, int end, int t) {
+        for (int i = start; i < end; ++i) {
+            range_of_vector[i] = t;
+            ids[i].resize(words[i].size());
+            for (size_t k = 0; k < words[i].size(); ++k) {
+                ids[i][k] = local_vocabularies[t].intern(words[i][k]);
+            }
+            std::vector<std::string>().swap(words[i]);
+        }
+    });
+    mjd::Vocabulary vocabulary;
+    std::vector<std::vector<int> > remaps = vocabulary.merge(local_vocabularies);
+    int vocab_size = vocabulary.size();
+
+    // the terms each vector contains more than threshold times.
+    std::vector<std::vector<int> > frequent(num_vectors);
+    mjd::parallel_for(num_vectors, cores, [&](int start, int end, int t) {
+        std::vector<int> counts(vocab_size, 0);
+        for (int i = start; i < end; ++i) {
+            const std::vector<int>& remap = remaps[range_of_vector[i]];
+            for (size_t k = 0; k < ids[i].size(); ++k) {
+                ids[i][k] = remap[ids[i][k]];
+                counts[ids[i][k]] += 1;
+            }
+            for (size_t k = 0; k < ids[i].size(); ++k) {
+                int term = ids[i][k];
+                if (counts[term] > threshold) {
+                    frequent[i].push_back(term);
+                }
+                counts[term] = 0;
+            }
+        }
+    });
+
+    std::vector<int> frequent_in(vocab_size, 0);
+    std::vector<int> frequent_vector(vocab_size, -1);
+    for (int i = 0; i < num_vectors; ++i) {
+        for (size_t k = 0; k < frequent[i].size(); ++k) {
+            frequent_in[frequent[i][k]] += 1;
+            frequent_vector[frequent[i][k]] = i;
+        }
+        std::vector<int>().swap(frequent[i]);
+    }
+
+    std::vector<std::vector<int> > keep(num_vectors);
+    mjd::parallel_for(num_vectors, cores, [&](int start, int end, int t) {
+        for (int i = start; i < end; ++i) {
+            keep[i].resize(ids[i].size());
+            for (size_t k = 0; k < ids[i].size(); ++k) {
+                int term = ids[i][k];
+                keep[i][k] = frequent_in[term] == 0 ||
+                    (frequent_in[term] == 1 && frequent_vector[term] == i);
+            }
+        }
+    });
+
+    List to_return(num_vectors);
+    for (int i = 0; i < num_vectors; ++i) {
+        to_return[i] = LogicalVector(keep[i].begin(), keep[i].end());
+    }
+    return to_return;
+}
+
+// Logical mask of the words in word_vector that appear more than threshold
+// times in it.
+// [[Rcpp::export]]
+LogicalVector Frequency_Threshold(std::vector<std::string> word_vector,
+                                  double threshold){
+    mjd::Vocabulary vocabulary;
+    std::vector<int> ids(word_vector.size());
+    std::vector<int> counts;
+    for (size_t k = 0; k < word_vector.size(); ++k) {
+        ids[k] = vocabulary.intern(word_vector[k]);
+        if (size_t(ids[k]) == counts.size()) {
+            counts.push_back(0);
+        }
+        counts[ids[k]] += 1;
+    }
+    LogicalVector keep(word_vector.size());
+    for (size_t k = 0; k < word_vector.size(); ++k) {
+        keep[k] = counts[ids[k]] > threshold;
+    }
+    return keep;
+}
@@ -0,0 +1,251 @@
+// [[Rcpp::plugins(cpp11)]]
+#include <RcppArmadillo.h>
+#include <string>
+#include "Block_File.h"
+#include "Vocabulary.h"
+#include "Parallel.h"
+//[[Rcpp::depends(RcppArmadillo)]]
+using namespace Rcpp;
+
+namespace mjd {
+    CharacterVector utf8_character_vector(const std::vector<std::string>& v);
+
+    // stop with the first error recorded by a worker thread, if any.
+    void stop_on_error(const std::vector<std::string>& errors) {
+        for (size_t k = 0; k < errors.size(); ++k) {
+            if (!errors[k].empty()) {
+                Rcpp::stop(errors[k]);
+            }
+        }
+    }
+}
+
+// [[Rcpp::export]]
+void Write_Document_Term_Block(
+        List document_term_vector_list,
+        List document_term_count_list,
+        std::string file){
+
+    int num_docs = document_term_vector_list.size();
+    bool using_counts = document_term_count_list.size() > 0;
+    if (using_counts && int(document_term_count_list.size()) != num_docs) {
+        Rcpp::stop("document_term_count_list must have one entry per document.");
+    }
+
+    mjd::Vocabulary vocabulary;
+    std::vector<uint64_t> offsets(1, 0);
+    std::vector<uint32_t> ids;
+    std::vector<double> counts;
+    for (int i = 0; i < num_docs; ++i) {
+        CharacterVector terms = document_term_vector_list[i];
+        int length = terms.size();
+        for (int k = 0; k < length; ++k) {
+            ids.push_back(vocabulary.intern(Rcpp::as<std::string>(terms[k])));
+        }
+        if (using_counts) {
+            NumericVector current = document_term_count_list[i];
+            if (int(current.size()) != length) {
+                Rcpp::stop("Document " + std::to_string(i + 1) + " has a different number of terms and counts.");
+            }
+            counts.insert(counts.end(), current.begin(), current.end());
+        }
+        offsets.push_back(ids.size());
+    }
+
+    std::string error;
+    if (!mjd::write_document_term_block(file, offsets, ids,
+                                        using_counts ? &counts : 0,
+                                        vocabulary.all_terms(), error)) {
+        Rcpp::stop(error);
+    }
+}
+
+// [[Rcpp::export]]
+List Read_Document_Term_Block(std::string file){
+
+    mjd::BlockReader block;
+    std::string error;
+    if (!block.open(file, error)) {
+        Rcpp::stop(error);
+    }
+    int num_docs = block.num_documents();
+
+    // every term is converted to an R string once and then reused.
+    CharacterVector terms(block.num_strings());
+    for (size_t k = 0; k < block.num_strings(); ++k) {
+        terms[k] = Rcpp::String(block.term(k), CE_UTF8);
+    }
+
+    List document_term_vector_list(num_docs);
+    List document_term_count_list(num_docs);
+    for (int i = 0; i < num_docs; ++i) {
+        size_t length = block.document_length(i);
+        const uint32_t* ids = block.document_ids(i);
+        CharacterVector doc(length);
+        for (size_t k = 0; k < length; ++k) {
+            doc[k] = terms[ids[k]];
+        }
+        document_term_vector_list[i] = doc;
+        if (block.has_counts()) {
+            const double* counts = block.document_counts(i);
+            document_term_count_list[i] = NumericVector(counts,
+                                                        counts + length);
+        }
+    }
+
+    List to_return(2);
+    to_return[0] = document_term_vector_list;
+    if (block.has_counts()) {
+        to_return[1] = document_term_count_list;
+    } else {
+        to_return[1] = R_NilValue;
+    }
+    return to_return;
+}
+
+// [[Rcpp::export]]
+List Block_Count_Words(std::vector<std::string> files,
+                       int cores){
+
+    int num_files = files.size();
+    int ranges = mjd::parallel_ranges(num_files, cores);
+    std::vector<mjd::Vocabulary> local_vocabularies(ranges);
+    std::vector<std::vector<double> > local_counts(ranges);
+    std::vector<std::string> errors(ranges);
+
+    mjd::parallel_for(num_files, cores, [&](int start, int end, int t) {
+        mjd::Vocabulary& vocabulary = local_vocabularies[t];
+        std::vector<double>& counts = local_counts[t];
+        std::vector<int> to_local;
+        for (int f = start; f < end; ++f) {
+            mjd::BlockReader block;
+            if (!block.open(files[f], errors[t])) {
+                return;
+            }
+            // string table entries are in first-seen order, so interning
+            // them in order preserves corpus wide first-seen order.
+            to_local.resize(block.num_strings());
+            for (size_t k = 0; k < block.num_strings(); ++k) {
+                to_local[k] = vocabulary.intern(block.term(k));
+                if (to_local[k] == int(counts.size())) {
+                    counts.push_back(0);
+                }
+            }
+            for (size_t i = 0; i < block.num_documents(); ++i) {
+                size_t length = block.document_length(i);
+                const uint32_t* ids = block.document_ids(i);
+                const double* weights = block.document_counts(i);
+                for (size_t k = 0; k < length; ++k) {
+                    counts[to_local[ids[k]]] += weights == 0 ? 1 : weights[k];
+                }
+            }
+        }
+    });
+    mjd::stop_on_error(errors);
+
+    mjd::Vocabulary vocabulary;
+    std::vector<std::vector<int> > remaps = vocabulary.merge(local_vocabularies);
+    NumericVector word_counts(vocabulary.size());
+    for (int t = 0; t < ranges; ++t) {
+        for (size_t k = 0; k < remaps[t].size(); ++k) {
+            word_counts[remaps[t][k]] += local_counts[t][k];
+        }
+    }
+
+    List to_return(2);
+    to_return[0] = mjd::utf8_character_vector(vocabulary.all_terms());
+    to_return[1] = word_counts;
+    return to_return;
+}
+
+// [[Rcpp::export]]
+List Block_Document_Term_Matrix(std::vector<std::string> files,
+                                std::vector<std::string> vocabulary,
+                                int cores){
+
+    int num_files = files.size();
+    mjd::Vocabulary lookup(vocabulary);
+    int num_terms = lookup.size();
+
+    struct BlockTriplets {
+        int num_docs = 0;
+        std::vector<int> rows;
+        std::vector<int> columns;
+        std::vector<double> values;
+    };
+    std::vector<BlockTriplets> blocks(num_files);
+    int ranges = mjd::parallel_ranges(num_files, cores);
+    std::vector<std::string> errors(ranges);
+
+    mjd::parallel_for(num_files, cores, [&](int start, int end, int t) {
+        // position of each term in the current document's row, or -1.
+        std::vector<int> position(num_terms, -1);
+        std::vector<int> to_global;
+        for (int f = start; f < end; ++f) {
+            mjd::BlockReader block;
+            if (!block.open(files[f], errors[t])) {
+                return;
+            }
+            to_global.resize(block.num_strings());
+            for (size_t k = 0; k < block.num_strings(); ++k) {
+                to_global[k] = lookup.find(block.term(k));
+            }
+            BlockTriplets& out = blocks[f];
+            out.num_docs = block.num_documents();
+            for (size_t i = 0; i < block.num_documents(); ++i) {
+                size_t row_start = out.columns.size();
+                size_t length = block.document_length(i);
+                const uint32_t* ids = block.document_ids(i);
+                const double* weights = block.document_counts(i);
+                for (size_t k = 0; k < length; ++k) {
+                    int column = to_global[ids[k]];
+                    if (column < 0) {
+                        continue;
+                    }
+                    double value = weights == 0 ? 1 : weights[k];
+                    if (position[column] < 0) {
+                        position[column] = out.columns.size();
+                        out.rows.push_back(i);
+                        out.columns.push_back(column);
+                        out.values.push_back(value);
+                    } else {
+                        out.values[position[column]] += value;
+                    }
+                }
+                for (size_t k = row_start; k < out.columns.size(); ++k) {
+                    position[out.columns[k]] = -1;
+                }
+            }
+        }
+    });
+    mjd::stop_on_error(errors);
+
+    size_t entries = 0;
+    for (int f = 0; f < num_files; ++f) {
+        entries += blocks[f].columns.size();
+    }
+    IntegerVector i(entries);
+    IntegerVector j(entries);
+    NumericVector v(entries);
+    size_t k = 0;
+    int row_offset = 0;
+    for (int f = 0; f < num_files; ++f) {
+        BlockTriplets& block = blocks[f];
+        for (size_t e = 0; e < block.columns.size(); ++e, ++k) {
+            i[k] = row_offset + block.rows[e] + 1;
+            j[k] = block.columns[e] + 1;
+            v[k] = block.values[e];
+        }
+        row_offset += block.num_docs;
+        std::vector<int>().swap(block.rows);
+        std::vector<int>().swap(block.columns);
+        std::vector<double>().swap(block.values);
+    }
+
+    List to_return(4);
+    to_return[0] = i;
+    to_return[1] = j;
+    to_return[2] = v;
+    to_return[3] = row_offset;
+    return to_return;
+}
@@ -0,0 +1,159 @@
+// [[Rcpp::plugins(cpp11)]]
+#include <RcppArmadillo.h>
+#include <cstdio>
+#include <string>
+#include "Corpus.h"
+#include "Duplicate_Detection.h"
+#include "Parallel.h"
+#include "Telemetry.h"
+//[[Rcpp::depends(RcppArmadillo)]]
+using namespace Rcpp;
+
+namespace mjd {
+    CharacterVector utf8_character_vector(const std::vector<std::string>& v);
+    Corpus& corpus_reference(SEXP pointer);
+
+    std::string hex_string(const uint64_t* words, int count) {
+        std::string hex(16 * count, '0');
+        char buffer[17];
+        for (int w = 0; w < count; ++w) {
+            std::snprintf(buffer, sizeof(buffer), "%016llx",
+                          static_cast<unsigned long long>(words[w]));
+            hex.replace(16 * w, 16, buffer);
+        }
+        return hex;
+    }
+
+    // Clusters a set of document fingerprints and returns them to R as the
+    // one based cluster of each document, the first document with the same
+    // content, the near duplicate pairs (one based documents and their
+    // Hamming distance), and each document's content hash and SimHash in
+    // hexadecimal.
+    List duplicate_cluster_list(const std::vector<DocumentFingerprint>& fingerprints,
+                                int max_distance,
+                                int cores,
+                                const std::string& name) {
+        PhaseTimer clustering(name + ".clustering");
+        DuplicateClusters clusters = find_duplicates(fingerprints, max_distance,
+                                                     cores);
+        clustering.stop();
+
+        int n = fingerprints.size();
+        IntegerVector cluster(n);
+        IntegerVector exact_of(n);
+        std::vector<std::string> content(n);
+        std::vector<std::string> simhash(n);
+        int exact = 0;
+        for (int d = 0; d < n; ++d) {
+            cluster[d] = clusters.cluster[d] + 1;
+            exact_of[d] = clusters.exact_of[d] + 1;
+            if (clusters.exact_of[d] != d) {
+                ++exact;
+            }
+            uint64_t words[2] = {fingerprints[d].content.high,
+                                 fingerprints[d].content.low};
+            content[d] = hex_string(words, 2);
+            simhash[d] = hex_string(&fingerprints[d].simhash, 1);
+        }
+        int num_pairs = clusters.near.size();
+        IntegerVector near_a(num_pairs);
+        IntegerVector near_b(num_pairs);
+        IntegerVector distance(num_pairs);
+        for (int k = 0; k < num_pairs; ++k) {
+            near_a[k] = clusters.near[k].a + 1;
+            near_b[k] = clusters.near[k].b + 1;
+            distance[k] = clusters.near[k].distance;
+        }
+        telemetry().counter(name + ".exact_duplicates") += exact;
+        telemetry().counter(name + ".near_duplicate_pairs") += num_pairs;
+
+        List to_return(7);
+        to_return[0] = cluster;
+        to_return[1] = exact_of;
+        to_return[2] = near_a;
+        to_return[3] = near_b;
+        to_return[4] = distance;
+        to_return[5] = utf8_character_vector(content);
+        to_return[6] = utf8_character_vector(simhash);
+        return to_return;
+    }
+}
+
+// Finds exact and near duplicates among raw text documents (one string per
+// document). Exact duplicates share a 128 bit hash of every byte; near
+// duplicates are pairs of distinct documents whose SimHashes over shingles
+// of whitespace separated tokens differ in at most max_distance bits (or
+// none are searched for if max_distance < 0). Documents are fingerprinted
+// and index tables searched on cores threads.
+// [[Rcpp::export]]
+List Text_Duplicate_Clusters(std::vector<std::string> text,
+                             int shingle_length,
+                             int max_distance,
+                             int cores){
+    mjd::PhaseTimer hashing("Text_Duplicate_Clusters.hashing");
+    int num_docs = text.size();
+    std::vector<mjd::DocumentFingerprint> fingerprints(num_docs);
+    mjd::parallel_for(num_docs, cores, [&](int start, int end, int t) {
+        std::vector<uint64_t> tokens;
+        for (int d = start; d < end; ++d) {
+            fingerprints[d] = mjd::text_fingerprint(text[d], shingle_length,
+                                                    tokens);
+        }
+    });
+    hashing.stop();
+    return mjd::duplicate_cluster_list(fingerprints, max_distance, cores,
+                                       "Text_Duplicate_Clusters");
+}
+
+// Finds exact and near duplicates among tokenized documents (a list of
+// character vectors), as Text_Duplicate_Clusters() does with tokens taken
+// as given.
+// [[Rcpp::export]]
+List Token_Duplicate_Clusters(List documents,
+                              int shingle_length,
+                              int max_distance,
+                              int cores){
+    mjd::PhaseTimer hashing("Token_Duplicate_Clusters.hashing");
+    int num_docs = documents.size();
+    std::vector<std::vector<std::string> > tokens(num_docs);
+    for (int d = 0; d < num_docs; ++d) {
+        tokens[d] = Rcpp::as<std::vector<std::string> >(documents[d]);
+    }
+    std::vector<mjd::DocumentFingerprint> fingerprints(num_docs);
+    mjd::parallel_for(num_docs, cores, [&](int start, int end, int t) {
+        std::vector<uint64_t> hashes;
+        std::string buffer;
+        for (int d = start; d < end; ++d) {
+            fingerprints[d] = mjd::token_fingerprint(tokens[d], shingle_length,
+                                                     hashes, buffer);
+        }
+    });
+    hashing.stop();
+    return mjd::duplicate_cluster_list(fingerprints, max_distance, cores,
+                                       "Token_Duplicate_Clusters");
+}
+
+// Finds exact and near duplicates among the documents of a corpus created by
+// Create_Corpus(), hashing their term ids rather than their strings.
+// [[Rcpp::export]]
+List Corpus_Duplicate_Clusters(SEXP corpus,
+                               int shingle_length,
+                               int max_distance,
+                               int cores){
+    mjd::Corpus& current = mjd::corpus_reference(corpus);
+    mjd::PhaseTimer hashing("Corpus_Duplicate_Clusters.hashing");
+    int num_docs = current.num_documents();
+    std::vector<mjd::DocumentFingerprint> fingerprints(num_docs);
+    mjd::parallel_for(num_docs, cores, [&](int start, int end, int t) {
+        std::vector<uint64_t> hashes;
+        for (int d = start; d < end; ++d) {
+            fingerprints[d] = mjd::id_fingerprint(current.document(d),
+                                                  current.length(d),
+                                                  shingle_length,
+                                                  hashes);
+        }
+    });
+    hashing.stop();
+    return mjd::duplicate_cluster_list(fingerprints, max_distance, cores,
+                                       "Corpus_Duplicate_Clusters");
+}
@@ -0,0 +1,401 @@
+#ifndef SPEEDREADER_DUPLICATE_DETECTION_H
+#define SPEEDREADER_DUPLICATE_DETECTION_H
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <cctype>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include "Parallel.h"
+#include "Term_Sketch.h"
+
+namespace mjd {
+
+    // A 128 bit hash of a document's content, used to find exact duplicates.
+    struct ContentHash {
+        uint64_t high;
+        uint64_t low;
+
+        bool operator==(const ContentHash& other) const {
+            return high == other.high && low == other.low;
+        }
+
+        bool operator<(const ContentHash& other) const {
+            return high < other.high || (high == other.high && low < other.low);
+        }
+    };
+
+    inline uint64_t rotate_left(uint64_t x, int r) {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    inline uint64_t murmur_finalize(uint64_t k) {
+        k ^= k >> 33;
+        k *= 0xff51afd7ed558ccdULL;
+        k ^= k >> 33;
+        k *= 0xc4ceb9fe1a85ec53ULL;
+        k ^= k >> 33;
+        return k;
+    }
+
+    // MurmurHash3 (x64, 128 bit) of a run of bytes.
+    inline ContentHash content_hash(const char* data, size_t length) {
+        const uint64_t c1 = 0x87c37b91114253d5ULL;
+        const uint64_t c2 = 0x4cf5ad432745937fULL;
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+        uint64_t h1 = 0;
+        uint64_t h2 = 0;
+        size_t blocks = length / 16;
+        for (size_t b = 0; b < blocks; ++b) {
+            uint64_t k1;
+            uint64_t k2;
+            std::memcpy(&k1, bytes + 16 * b, 8);
+            std::memcpy(&k2, bytes + 16 * b + 8, 8);
+            k1 *= c1;
+            k1 = rotate_left(k1, 31);
+            k1 *= c2;
+            h1 ^= k1;
+            h1 = rotate_left(h1, 27);
+            h1 += h2;
+            h1 = h1 * 5 + 0x52dce729;
+            k2 *= c2;
+            k2 = rotate_left(k2, 33);
+            k2 *= c1;
+            h2 ^= k2;
+            h2 = rotate_left(h2, 31);
+            h2 += h1;
+            h2 = h2 * 5 + 0x38495ab5;
+        }
+        const unsigned char* tail = bytes + 16 * blocks;
+        size_t remainder = length & 15;
+        uint64_t k1 = 0;
+        uint64_t k2 = 0;
+        for (size_t i = remainder; i > 8; --i) {
+            k2 ^= uint64_t(tail[i - 1]) << ((i - 9) * 8);
+        }
+        if (remainder > 8) {
+            k2 *= c2;
+            k2 = rotate_left(k2, 33);
+            k2 *= c1;
+            h2 ^= k2;
+        }
+        for (size_t i = std::min(remainder, size_t(8)); i > 0; --i) {
+            k1 ^= uint64_t(tail[i - 1]) << ((i - 1) * 8);
+        }
+        if (remainder > 0) {
+            k1 *= c1;
+            k1 = rotate_left(k1, 31);
+            k1 *= c2;
+            h1 ^= k1;
+        }
+        h1 ^= length;
+        h2 ^= length;
+        h1 += h2;
+        h2 += h1;
+        h1 = murmur_finalize(h1);
+        h2 = murmur_finalize(h2);
+        h1 += h2;
+        h2 += h1;
+        ContentHash hash = {h1, h2};
+        return hash;
+    }
+
+    // The exact and near duplicate fingerprints of one document. Documents
+    // with no tokens have no SimHash features and can only be exact
+    // duplicates.
+    struct DocumentFingerprint {
+        ContentHash content;
+        uint64_t simhash;
+        bool has_features;
+    };
+
+    // 64 bit SimHash of a document given the hash of each of its tokens.
+    // Each shingle of shingle_length consecutive tokens (or the whole
+    // document, if it is shorter) is hashed, and bit b of the fingerprint is
+    // set if more shingles have bit b set than not, so documents sharing
+    // most of their shingles differ in few bits.
+    inline uint64_t shingle_simhash(const std::vector<uint64_t>& tokens,
+                                    int shingle_length) {
+        if (tokens.empty()) {
+            return 0;
+        }
+        size_t width = std::min(tokens.size(),
+                                size_t(std::max(1, shingle_length)));
+        int weights[64] = {0};
+        for (size_t k = 0; k + width <= tokens.size(); ++k) {
+            uint64_t hash = 0x9e3779b97f4a7c15ULL;
+            for (size_t j = 0; j < width; ++j) {
+                hash = murmur_finalize(rotate_left(hash, 17) ^ tokens[k + j]);
+            }
+            for (int b = 0; b < 64; ++b) {
+                weights[b] += ((hash >> b) & 1) ? 1 : -1;
+            }
+        }
+        uint64_t fingerprint = 0;
+        for (int b = 0; b < 64; ++b) {
+            if (weights[b] > 0) {
+                fingerprint |= uint64_t(1) << b;
+            }
+        }
+        return fingerprint;
+    }
+
+    // Fingerprints of raw text. The content hash covers every byte, and
+    // SimHash shingles are built from runs of non-whitespace characters.
+    inline DocumentFingerprint text_fingerprint(const std::string& text,
+                                                int shingle_length,
+                                                std::vector<uint64_t>& tokens) {
+        tokens.clear();
+        size_t start = 0;
+        while (start < text.size()) {
+            while (start < text.size() &&
+                   std::isspace(static_cast<unsigned char>(text[start]))) {
+                ++start;
+            }
+            size_t end = start;
+            while (end < text.size() &&
+                   !std::isspace(static_cast<unsigned char>(text[end]))) {
+                ++end;
+            }
+            if (end > start) {
+                tokens.push_back(term_hash(text.data() + start, end - start));
+            }
+            start = end;
+        }
+        DocumentFingerprint fingerprint;
+        fingerprint.content = content_hash(text.data(), text.size());
+        fingerprint.simhash = shingle_simhash(tokens, shingle_length);
+        fingerprint.has_features = !tokens.empty();
+        return fingerprint;
+    }
+
+    // Fingerprints of a tokenized document. The content hash covers the
+    // tokens, each followed by a zero byte so token boundaries count.
+    inline DocumentFingerprint token_fingerprint(const std::vector<std::string>& document,
+                                                 int shingle_length,
+                                                 std::vector<uint64_t>& tokens,
+                                                 std::string& buffer) {
+        tokens.resize(document.size());
+        buffer.clear();
+        for (size_t k = 0; k < document.size(); ++k) {
+            tokens[k] = term_hash(document[k].data(), document[k].size());
+            buffer.append(document[k]);
+            buffer.push_back('\0');
+        }
+        DocumentFingerprint fingerprint;
+        fingerprint.content = content_hash(buffer.data(), buffer.size());
+        fingerprint.simhash = shingle_simhash(tokens, shingle_length);
+        fingerprint.has_features = !tokens.empty();
+        return fingerprint;
+    }
+
+    // Fingerprints of a document of interned term ids (see Corpus.h), which
+    // only compare equal to documents interned into the same vocabulary.
+    inline DocumentFingerprint id_fingerprint(const int* ids,
+                                              size_t length,
+                                              int shingle_length,
+                                              std::vector<uint64_t>& tokens) {
+        tokens.resize(length);
+        for (size_t k = 0; k < length; ++k) {
+            tokens[k] = murmur_finalize(uint64_t(ids[k]) + 0x9e3779b97f4a7c15ULL);
+        }
+        DocumentFingerprint fingerprint;
+        fingerprint.content = content_hash(reinterpret_cast<const char*>(ids),
+                                           length * sizeof(int));
+        fingerprint.simhash = shingle_simhash(tokens, shingle_length);
+        fingerprint.has_features = length > 0;
+        return fingerprint;
+    }
+
+    inline int hamming_distance(uint64_t a, uint64_t b) {
+        uint64_t x = a ^ b;
+        int distance = 0;
+        while (x != 0) {
+            x &= x - 1;
+            ++distance;
+        }
+        return distance;
+    }
+
+    // Finds documents within max_distance bits of each other among a set of
+    // SimHash fingerprints. The 64 bits are cut into max_distance + 1
+    // blocks; by the pigeonhole principle two fingerprints that close agree
+    // exactly on at least one block. Each block gets its own table, the
+    // fingerprints permuted so that block comes first and sorted, so
+    // candidates are the runs sharing it. A pair is only reported by the
+    // first block it agrees on, so tables can be searched independently (on
+    // cores threads) without repeating pairs.
+    class SimHashIndex {
+    public:
+        struct Match {
+            int a;
+            int b;
+            int distance;
+
+            bool operator<(const Match& other) const {
+                return a < other.a || (a == other.a && b < other.b);
+            }
+        };
+
+        SimHashIndex(const std::vector<uint64_t>& fingerprints,
+                     const std::vector<int>& documents,
+                     int max_distance)
+            : fingerprints(fingerprints),
+              documents(documents),
+              max_distance(std::max(0, std::min(63, max_distance))),
+              blocks(this->max_distance + 1) {}
+
+        std::vector<Match> matches(int cores) const {
+            std::vector<std::vector<Match> > found(blocks);
+            parallel_for(blocks, cores, [&](int start, int end, int t) {
+                for (int b = start; b < end; ++b) {
+                    search_table(b, found[b]);
+                }
+            });
+            std::vector<Match> all;
+            for (int b = 0; b < blocks; ++b) {
+                all.insert(all.end(), found[b].begin(), found[b].end());
+            }
+            std::sort(all.begin(), all.end());
+            return all;
+        }
+
+    private:
+        const std::vector<uint64_t>& fingerprints;
+        const std::vector<int>& documents;
+        int max_distance;
+        int blocks;
+
+        uint64_t block_key(uint64_t fingerprint, int b) const {
+            int start = 64 * b / blocks;
+            int end = 64 * (b + 1) / blocks;
+            uint64_t mask = end - start == 64 ? ~uint64_t(0) :
+                (uint64_t(1) << (end - start)) - 1;
+            return (fingerprint >> start) & mask;
+        }
+
+        void search_table(int b, std::vector<Match>& found) const {
+            std::vector<std::pair<uint64_t, int> > table(fingerprints.size());
+            for (size_t k = 0; k < fingerprints.size(); ++k) {
+                table[k] = std::make_pair(block_key(fingerprints[k], b), int(k));
+            }
+            std::sort(table.begin(), table.end());
+            size_t start = 0;
+            while (start < table.size()) {
+                size_t end = start + 1;
+                while (end < table.size() && table[end].first == table[start].first) {
+                    ++end;
+                }
+                for (size_t i = start; i < end; ++i) {
+                    uint64_t x = fingerprints[table[i].second];
+                    for (size_t j = i + 1; j < end; ++j) {
+                        uint64_t y = fingerprints[table[j].second];
+                        int distance = hamming_distance(x, y);
+                        if (distance > max_distance || agree_before(x, y, b)) {
+                            continue;
+                        }
+                        Match match = {documents[table[i].second],
+                                       documents[table[j].second],
+                                       distance};
+                        found.push_back(match);
+                    }
+                }
+                start = end;
+            }
+        }
+
+        bool agree_before(uint64_t x, uint64_t y, int b) const {
+            for (int c = 0; c < b; ++c) {
+                if (block_key(x, c) == block_key(y, c)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    // Exact and near duplicate clusters. exact_of is the first document with
+    // the same content hash (or the document itself), near holds pairs of
+    // such first documents whose SimHashes are within max_distance bits,
+    // and cluster joins both, numbered from zero in order of each cluster's
+    // first document.
+    struct DuplicateClusters {
+        std::vector<int> exact_of;
+        std::vector<SimHashIndex::Match> near;
+        std::vector<int> cluster;
+    };
+
+    inline int find_root(std::vector<int>& parent, int x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+
+    inline DuplicateClusters find_duplicates(const std::vector<DocumentFingerprint>& fingerprints,
+                                             int max_distance,
+                                             int cores) {
+        int n = fingerprints.size();
+        DuplicateClusters result;
+
+        // exact duplicates: group equal content hashes, first document first.
+        std::vector<int> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](int a, int b) {
+            if (fingerprints[a].content == fingerprints[b].content) {
+                return a < b;
+            }
+            return fingerprints[a].content < fingerprints[b].content;
+        });
+        result.exact_of.resize(n);
+        for (int k = 0; k < n; ++k) {
+            bool same = k > 0 &&
+                fingerprints[order[k]].content == fingerprints[order[k - 1]].content;
+            result.exact_of[order[k]] = same ? result.exact_of[order[k - 1]] : order[k];
+        }
+
+        // near duplicates among the first document of each exact group.
+        std::vector<uint64_t> simhashes;
+        std::vector<int> documents;
+        for (int d = 0; d < n; ++d) {
+            if (result.exact_of[d] == d && fingerprints[d].has_features) {
+                simhashes.push_back(fingerprints[d].simhash);
+                documents.push_back(d);
+            }
+        }
+        if (max_distance >= 0) {
+            SimHashIndex index(simhashes, documents, max_distance);
+            result.near = index.matches(cores);
+        }
+
+        std::vector<int> parent(n);
+        std::iota(parent.begin(), parent.end(), 0);
+        // every root is the first document of its cluster.
+        for (size_t k = 0; k < result.near.size(); ++k) {
+            int a = find_root(parent, result.near[k].a);
+            int b = find_root(parent, result.near[k].b);
+            parent[std::max(a, b)] = std::min(a, b);
+        }
+        for (int d = 0; d < n; ++d) {
+            parent[d] = find_root(parent, result.exact_of[d]);
+        }
+        result.cluster.assign(n, -1);
+        int clusters = 0;
+        for (int d = 0; d < n; ++d) {
+            int root = find_root(parent, d);
+            if (result.cluster[root] < 0) {
+                result.cluster[root] = clusters++;
+            }
+            result.cluster[d] = result.cluster[root];
+        }
+        return result;
+    }
+
+}
+
+#endif
@@ -2,6 +2,7 @@
 #include <RcppArmadillo.h>
 #include <string>
 #include <unordered_set>
+#include "Telemetry.h"
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string/classification.hpp>
 //[[Rcpp::depends(RcppArmadillo)]]
@@ -198,6 +199,7 @@ arma::mat Efficient_Block_Sequential_String_Set_Hash_Comparison(
     int ignore_counter = 0;
     int cur_check = to_ignore[0];
 
+    mjd::PhaseTimer hashing("Efficient_Block_Sequential_String_Set_Hash_Comparison.hashing");
     //loop through documents and form ngrams/hash them
     for(int i = 0; i < num_docs; ++i){
         // if we are ignoring documents then we check to see if we hash first
@@ -245,14 +247,16 @@ arma::mat Efficient_Block_Sequential_String_Set_Hash_Comparison(
         }
     }
 
-    Rcpp::Rcout << "Hashing Complete..." << std::endl;
+    hashing.stop();
+    mjd::telemetry().counter("Efficient_Block_Sequential_String_Set_Hash_Comparison.documents") += num_docs;
+
+    mjd::PhaseTimer comparing("Efficient_Block_Sequential_String_Set_Hash_Comparison.comparing");
+    mjd::Progress progress("Current Comparison", num_comparisons);
 
     // LOOP OVER ALL COMPARISONS
     for(int i = 0; i < num_comparisons; ++i){
 
-        if (i % 1000 == 0) {
-            Rcpp::Rcout << "Current Comparison: " << i << " of " << num_comparisons << std::endl;
-        }
+        progress.update(i);
 
         std::unordered_set<std::string> dictionary1 = dictionaries[comparison_inds(i,0)];
         std::unordered_set<std::string> dictionary2 = dictionaries[comparison_inds(i,1)];
@@ -286,6 +290,8 @@ arma::mat Efficient_Block_Sequential_String_Set_Hash_Comparison(
 
     }
 
+    progress.finish();
+    mjd::telemetry().counter("Efficient_Block_Sequential_String_Set_Hash_Comparison.comparisons") += num_comparisons;
     return comparison_metrics;
 }
 
@@ -310,6 +316,7 @@ arma::mat Efficient_Block_Hash_Ngrams(
     int ignore_counter = 0;
     int cur_check = to_ignore[0];
 
+    mjd::PhaseTimer hashing("Efficient_Block_Hash_Ngrams.hashing");
     //loop through documents and form ngrams/hash them
     for(int i = 0; i < num_docs; ++i){
         bool hash = true;
@@ -366,14 +373,16 @@ arma::mat Efficient_Block_Hash_Ngrams(
         }
     }
 
-    Rcpp::Rcout << "Hashing Complete..." << std::endl;
+    hashing.stop();
+    mjd::telemetry().counter("Efficient_Block_Hash_Ngrams.documents") += num_docs;
+
+    mjd::PhaseTimer comparing("Efficient_Block_Hash_Ngrams.comparing");
+    mjd::Progress progress("Current Comparison", num_comparisons);
 
     // LOOP OVER ALL COMPARISONS
     for(int i = 0; i < num_comparisons; ++i){
 
-        if (i % 10000 == 0) {
-            Rcpp::Rcout << "Current Comparison: " << i << " of " << num_comparisons << std::endl;
-        }
+        progress.update(i);
 
         std::unordered_set<std::string> dictionary1 = dictionaries[comparison_inds(i,0)];
         std::unordered_set<std::string> dictionary2 = dictionaries[comparison_inds(i,1)];
@@ -406,6 +415,8 @@ arma::mat Efficient_Block_Hash_Ngrams(
 
     }
 
+    progress.finish();
+    mjd::telemetry().counter("Efficient_Block_Hash_Ngrams.comparisons") += num_comparisons;
     return comparison_metrics;
 }
 
@@ -431,6 +442,7 @@ arma::mat String_Input_Sequential_String_Set_Hash_Comparison(
     int ignore_counter = 0;
     int cur_check = to_ignore[0];
 
+    mjd::PhaseTimer hashing("String_Input_Sequential_String_Set_Hash_Comparison.hashing");
     //loop through documents and form ngrams/hash them
     for (int i = 0; i < num_docs; ++i) {
         // if we are ignoring documents then we check to see if we hash first
@@ -488,14 +500,16 @@ arma::mat String_Input_Sequential_String_Set_Hash_Comparison(
         }
     }
 
-    Rcpp::Rcout << "Hashing Complete..." << std::endl;
+    hashing.stop();
+    mjd::telemetry().counter("String_Input_Sequential_String_Set_Hash_Comparison.documents") += num_docs;
+
+    mjd::PhaseTimer comparing("String_Input_Sequential_String_Set_Hash_Comparison.comparing");
+    mjd::Progress progress("Current Comparison", num_comparisons);
 
     // LOOP OVER ALL COMPARISONS
     for(int i = 0; i < num_comparisons; ++i){
 
-        if (i % 1000 == 0) {
-            Rcpp::Rcout << "Current Comparison: " << i << " of " << num_comparisons << std::endl;
-        }
+        progress.update(i);
 
         std::unordered_set<std::string> dictionary1 = dictionaries[comparison_inds(i,0)];
         std::unordered_set<std::string> dictionary2 = dictionaries[comparison_inds(i,1)];
@@ -529,6 +543,8 @@ arma::mat String_Input_Sequential_String_Set_Hash_Comparison(
 
     }
 
+    progress.finish();
+    mjd::telemetry().counter("String_Input_Sequential_String_Set_Hash_Comparison.comparisons") += num_comparisons;
     return comparison_metrics;
 }
 
@@ -0,0 +1,86 @@
+// [[Rcpp::plugins(cpp11)]]
+#include <RcppArmadillo.h>
+#include <string>
+#include "NGram_Extractor.h"
+#include "Parallel.h"
+//[[Rcpp::depends(RcppArmadillo)]]
+using namespace Rcpp;
+
+// Takes one token vector (words or lemmas) per document, plus punctuation and
+// numeric indicator columns that are only read (and may be empty lists) when
+// those tokens are removed. Tokens are copied into arenas on the main thread,
+// n-grams are extracted in parallel over documents, and the result is one list
+// per document with a character vector (or NULL if the document is too short)
+// per n-gram length.
+// [[Rcpp::export]]
+List Extract_NGrams(List token_list,
+                    List punctuation_list,
+                    List numeric_list,
+                    std::vector<int> ngram_lengths,
+                    bool remove_punctuation,
+                    bool remove_numeric,
+                    int cores){
+
+    int num_docs = token_list.size();
+    for (size_t l = 0; l < ngram_lengths.size(); ++l) {
+        if (ngram_lengths[l] < 1) {
+            Rcpp::stop("ngram_lengths must all be positive integers.");
+        }
+    }
+
+    std::vector<mjd::TokenArena> documents(num_docs);
+    for (int d = 0; d < num_docs; ++d) {
+        std::vector<std::string> tokens =
+            Rcpp::as<std::vector<std::string> >(token_list[d]);
+        int num_tokens = tokens.size();
+        NumericVector punctuation;
+        NumericVector numeric;
+        if (remove_punctuation) {
+            punctuation = punctuation_list[d];
+        }
+        if (remove_numeric) {
+            numeric = numeric_list[d];
+        }
+        if ((remove_punctuation && int(punctuation.size()) != num_tokens) ||
+            (remove_numeric && int(numeric.size()) != num_tokens)) {
+            Rcpp::stop("Document " + std::to_string(d + 1) + " has token columns of different lengths.");
+        }
+        mjd::TokenArena& document = documents[d];
+        document.offsets.reserve(tokens.size() + 1);
+        document.blocked.reserve(tokens.size());
+        for (size_t k = 0; k < tokens.size(); ++k) {
+            bool blocked = (remove_punctuation && punctuation[k] != 0) ||
+                (remove_numeric && numeric[k] != 0);
+            document.append(tokens[k], blocked);
+        }
+    }
+
+    std::vector<std::vector<mjd::NGramArena> > extracted(num_docs);
+    mjd::parallel_for(num_docs, cores, [&](int start, int end, int t) {
+        for (int d = start; d < end; ++d) {
+            mjd::extract_ngrams(documents[d], ngram_lengths, extracted[d]);
+            std::vector<size_t>().swap(documents[d].offsets);
+            std::string().swap(documents[d].text);
+        }
+    });
+
+    List to_return(num_docs);
+    for (int d = 0; d < num_docs; ++d) {
+        List document_ngrams(ngram_lengths.size());
+        for (size_t l = 0; l < ngram_lengths.size(); ++l) {
+            if (documents[d].blocked.size() < size_t(ngram_lengths[l])) {
+                document_ngrams[l] = R_NilValue;
+                continue;
+            }
+            const mjd::NGramArena& arena = extracted[d][l];
+            CharacterVector ngrams(arena.size());
+            for (size_t k = 0; k < arena.size(); ++k) {
+                ngrams[k] = Rcpp::String(arena.ngram(k), CE_UTF8);
+            }
+            document_ngrams[l] = ngrams;
+        }
+        std::vector<mjd::NGramArena>().swap(extracted[d]);
+        to_return[d] = document_ngrams;
+    }
+    return to_return;
+}
@@ -1,4 +1,5 @@
 #include <RcppArmadillo.h>
+#include "Telemetry.h"
 //[[Rcpp::depends(RcppArmadillo)]]
 using namespace Rcpp;
 
@@ -15,8 +16,10 @@ arma::mat Generate_Document_Term_Matrix(
 
   arma::mat document_word_matrix = arma::zeros(number_of_documents,number_of_unique_words);
 
+  mjd::PhaseTimer counting("Generate_Document_Term_Matrix.counting");
+  mjd::Progress progress("Current Document", number_of_documents);
   for(int n = 0; n < number_of_documents; ++n){
-    Rcpp::Rcout << "Current Document: " << n << std::endl;
+    progress.update(n);
     int length = Document_Lengths[n];
     if(length > 0){
       std::vector<std::string> current = Document_Words[n];
@@ -44,6 +47,9 @@ arma::mat Generate_Document_Term_Matrix(
     }
   }
 
+  progress.finish();
+  mjd::telemetry().counter("Generate_Document_Term_Matrix.documents") += number_of_documents;
+
   //return
   return document_word_matrix;
 
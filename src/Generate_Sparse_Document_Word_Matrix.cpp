@@ -1,4 +1,5 @@
 #include <RcppArmadillo.h>
+#include "Telemetry.h"
 //[[Rcpp::depends(RcppArmadillo)]]
 using namespace Rcpp;
 
@@ -17,8 +18,10 @@ List Generate_Sparse_Document_Term_Matrix(
     arma::vec term_indices = arma::zeros(total_terms);
     arma::vec counts = arma::zeros(total_terms);
     int total_counter = 0;
+    mjd::PhaseTimer counting("Generate_Sparse_Document_Term_Matrix.counting");
+    mjd::Progress progress("Current Document", number_of_documents);
     for(int n = 0; n < number_of_documents; ++n){
-        Rcpp::Rcout << "Current Document: " << n << std::endl;
+        progress.update(n);
         int length = Document_Lengths[n];
         if(length > 0){
             std::vector<std::string> current = Document_Words[n];
@@ -44,6 +47,10 @@ List Generate_Sparse_Document_Term_Matrix(
             }
         }
     }
+    progress.finish();
+    mjd::telemetry().counter("Generate_Sparse_Document_Term_Matrix.documents") += number_of_documents;
+    mjd::telemetry().counter("Generate_Sparse_Document_Term_Matrix.entries") += total_counter;
+
     //remove excess zeros
     arma::vec ret_document_indices = arma::zeros(total_counter);
     arma::vec ret_term_indices = arma::zeros(total_counter);
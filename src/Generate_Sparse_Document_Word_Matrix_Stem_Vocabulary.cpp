@@ -1,5 +1,6 @@
 #include <RcppArmadillo.h>
 #include <string>
+#include "Telemetry.h"
 //[[Rcpp::depends(RcppArmadillo)]]
 using namespace Rcpp;
 
@@ -25,8 +26,10 @@ List Generate_Sparse_Document_Term_Matrix_Stem_Vocabulary(
     int stems_found = 0;
     //Rcpp::Rcout << "Lookup Size: " << lookup_size << std::endl;
     int total_counter = 0;
+    mjd::PhaseTimer counting("Generate_Sparse_Document_Term_Matrix_Stem_Vocabulary.counting");
+    mjd::Progress progress("Current Document", number_of_documents);
     for(int n = 0; n < number_of_documents; ++n){
-        Rcpp::Rcout << "Current Document: " << n << std::endl;
+        progress.update(n);
         int length = Document_Lengths[n];
         if(length > 0){
             std::vector<std::string> current = Document_Words[n];
@@ -81,9 +84,11 @@ List Generate_Sparse_Document_Term_Matrix_Stem_Vocabulary(
             }
         }
     }
+    progress.finish();
+    mjd::telemetry().counter("Generate_Sparse_Document_Term_Matrix_Stem_Vocabulary.documents") += number_of_documents;
+    mjd::telemetry().counter("Generate_Sparse_Document_Term_Matrix_Stem_Vocabulary.entries") += total_counter;
+    mjd::telemetry().counter("Generate_Sparse_Document_Term_Matrix_Stem_Vocabulary.stems_found") += stems_found;
     //remove excess zeros
-    Rcpp::Rcout << "Total Counter: " << total_counter << std::endl;
-    //Rcpp::Rcout << "Stems Found: " << stems_found<< std::endl;
     arma::vec ret_document_indices = arma::zeros(total_counter);
     arma::vec ret_term_indices = arma::zeros(total_counter);
     arma::vec ret_counts = arma::zeros(total_counter);
@@ -0,0 +1,255 @@
+#ifndef SPEEDREADER_INGEST_PIPELINE_H
+#define SPEEDREADER_INGEST_PIPELINE_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <condition_variable>
+#include "Tokenizer.h"
+#include "Vocabulary.h"
+#include "CSR_Matrix.h"
+#include "Bounded_Queue.h"
+
+namespace mjd {
+
+    // Read a whole file into out, dropping a leading UTF-8 byte order mark as
+    // readr::read_lines() does. Returns false if the file cannot be read.
+    inline bool read_text_file(const std::string& path, std::string& out) {
+        std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+        if (!file) {
+            return false;
+        }
+        file.seekg(0, std::ios::end);
+        std::streamoff size = file.tellg();
+        if (size < 0) {
+            return false;
+        }
+        out.resize(size_t(size));
+        file.seekg(0, std::ios::beg);
+        if (size > 0 && !file.read(&out[0], size)) {
+            return false;
+        }
+        if (out.size() >= 3 && out.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+            out.erase(0, 3);
+        }
+        return true;
+    }
+
+    struct IngestResult {
+        CSRMatrix matrix;
+        Vocabulary vocabulary;
+        // corpus wide count of every term in the vocabulary.
+        std::vector<double> term_counts;
+        std::string error;
+    };
+
+    namespace ingest {
+        struct RawDocument {
+            int index;
+            std::string text;
+        };
+
+        // the unique terms of one document, in first-seen order, with counts.
+        struct DocumentTerms {
+            int index;
+            std::vector<std::string> terms;
+            std::vector<double> counts;
+        };
+    }
+
+    // Stream files through reader -> tokenizer -> indexer stages connected by
+    // bounded queues. One reader thread loads files in order, tokenizer
+    // threads turn each file into unique terms and counts, and a single
+    // indexer thread interns the terms into the shared vocabulary and appends
+    // one CSR row per file, in file order. At most max_in_flight documents
+    // are held in memory between the reader and the indexer at any time.
+    inline IngestResult ingest_text_files(const std::vector<std::string>& files,
+                                          const Tokenizer& tokenizer,
+                                          int cores,
+                                          int queue_size) {
+        IngestResult result;
+        int num_files = files.size();
+        if (queue_size < 1) {
+            queue_size = 1;
+        }
+        if (cores < 1) {
+            cores = std::thread::hardware_concurrency();
+        }
+        // the reader and indexer get a thread each, the rest tokenize.
+        int tokenizer_threads = std::max(1, cores - 2);
+        if (tokenizer_threads > num_files) {
+            tokenizer_threads = std::max(1, num_files);
+        }
+        int max_in_flight = 2 * queue_size + tokenizer_threads;
+
+        BoundedQueue<ingest::RawDocument> raw_queue(queue_size);
+        BoundedQueue<ingest::DocumentTerms> term_queue(queue_size);
+        std::atomic<bool> failed(false);
+        std::mutex error_mutex;
+        std::mutex window_mutex;
+        std::condition_variable window_moved;
+        int indexed = 0;
+        std::atomic<int> tokenizers_running(tokenizer_threads);
+
+        // errors are recorded and every queue is closed so all stages wind
+        // down. Nothing in here may throw or touch the R API.
+        auto fail = [&](const std::string& message) {
+            {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (result.error.empty()) {
+                    result.error = message;
+                }
+            }
+            failed = true;
+            raw_queue.close();
+            term_queue.close();
+            std::lock_guard<std::mutex> lock(window_mutex);
+            window_moved.notify_all();
+        };
+
+        std::thread reader([&]() {
+            for (int i = 0; i < num_files && !failed; ++i) {
+                {
+                    std::unique_lock<std::mutex> lock(window_mutex);
+                    window_moved.wait(lock, [&] {
+                        return i < indexed + max_in_flight || failed;
+                    });
+                }
+                ingest::RawDocument doc;
+                doc.index = i;
+                if (!read_text_file(files[i], doc.text)) {
+                    fail("Could not read file: " + files[i]);
+                    break;
+                }
+                if (!raw_queue.push(std::move(doc))) {
+                    break;
+                }
+            }
+            raw_queue.close();
+        });
+
+        std::vector<std::thread> tokenizers;
+        for (int t = 0; t < tokenizer_threads; ++t) {
+            tokenizers.push_back(std::thread([&]() {
+                ingest::RawDocument doc;
+                std::unordered_map<std::string, int> position;
+                while (raw_queue.pop(doc)) {
+                    ingest::DocumentTerms terms;
+                    terms.index = doc.index;
+                    position.clear();
+                    tokenizer.tokenize(
+                        doc.text.data(), doc.text.size(),
+                        [&](const std::string& token) {
+                            std::unordered_map<std::string, int>::iterator got =
+                                position.find(token);
+                            if (got == position.end()) {
+                                position.insert(
+                                    std::make_pair(token, int(terms.terms.size())));
+                                terms.terms.push_back(token);
+                                terms.counts.push_back(1);
+                            } else {
+                                terms.counts[got->second] += 1;
+                            }
+                        });
+                    std::string().swap(doc.text);
+                    if (!term_queue.push(std::move(terms))) {
+                        break;
+                    }
+                }
+                // the last tokenizer out closes the queue to the indexer.
+                if (--tokenizers_running == 0) {
+                    term_queue.close();
+                }
+            }));
+        }
+
+        std::thread indexer([&]() {
+            // documents can finish tokenizing out of order, so they wait
+            // here until every earlier document has been indexed.
+            std::map<int, ingest::DocumentTerms> pending;
+            ingest::DocumentTerms terms;
+            CSRMatrix& matrix = result.matrix;
+            while (term_queue.pop(terms)) {
+                int index = terms.index;
+                pending[index] = std::move(terms);
+                std::map<int, ingest::DocumentTerms>::iterator next =
+                    pending.begin();
+                int advanced = 0;
+                while (next != pending.end() &&
+                       next->first == matrix.num_rows()) {
+                    const ingest::DocumentTerms& doc = next->second;
+                    for (size_t k = 0; k < doc.terms.size(); ++k) {
+                        int id = result.vocabulary.intern(doc.terms[k]);
+                        if (id == int(result.term_counts.size())) {
+                            result.term_counts.push_back(0);
+                        }
+                        result.term_counts[id] += doc.counts[k];
+                        matrix.append(id, doc.counts[k]);
+                    }
+                    matrix.end_row();
+                    pending.erase(next);
+                    next = pending.begin();
+                    advanced += 1;
+                }
+                if (advanced > 0) {
+                    std::lock_guard<std::mutex> lock(window_mutex);
+                    indexed = matrix.num_rows();
+                    window_moved.notify_all();
+                }
+            }
+        });
+
+        reader.join();
+        for (size_t t = 0; t < tokenizers.size(); ++t) {
+            tokenizers[t].join();
+        }
+        indexer.join();
+
+        result.matrix.num_columns = result.vocabulary.size();
+        if (result.error.empty() && result.matrix.num_rows() != num_files) {
+            result.error = "Native ingest pipeline ended before all files were indexed.";
+        }
+        return result;
+    }
+
+    // Second phase of ingest: drop every term that appears fewer than
+    // threshold times in the corpus and renumber the survivors from most to
+    // least frequent (ties keep first-seen order, as Count_Words() does).
+    // The CSR rows are remapped in place, so the text is never re-read.
+    inline void prune_vocabulary(IngestResult& result, double threshold) {
+        int num_terms = result.vocabulary.size();
+        std::vector<int> kept;
+        kept.reserve(num_terms);
+        for (int i = 0; i < num_terms; ++i) {
+            if (result.term_counts[i] >= threshold) {
+                kept.push_back(i);
+            }
+        }
+        const std::vector<double>& counts = result.term_counts;
+        std::stable_sort(kept.begin(), kept.end(), [&counts](int a, int b) {
+            return counts[a] > counts[b];
+        });
+
+        std::vector<int> remap(num_terms, -1);
+        Vocabulary vocabulary;
+        vocabulary.reserve(kept.size());
+        std::vector<double> term_counts(kept.size());
+        for (size_t k = 0; k < kept.size(); ++k) {
+            remap[kept[k]] = k;
+            vocabulary.intern(result.vocabulary.term(kept[k]));
+            term_counts[k] = counts[kept[k]];
+        }
+        result.matrix.remap_columns(remap, kept.size());
+        result.vocabulary = std::move(vocabulary);
+        result.term_counts.swap(term_counts);
+    }
+
+}
+
+#endif
@@ -0,0 +1,56 @@
+// [[Rcpp::plugins(cpp11)]]
+#include <RcppArmadillo.h>
+#include <string>
+#include "Ingest_Pipeline.h"
+//[[Rcpp::depends(RcppArmadillo)]]
+using namespace Rcpp;
+
+namespace mjd {
+    CharacterVector utf8_character_vector(const std::vector<std::string>& v);
+}
+
+// [[Rcpp::export]]
+List Ingest_Raw_Text(
+        std::vector<std::string> files,
+        std::vector<int> keep_characters,
+        int non_ascii_mode,
+        double term_frequency_threshold,
+        int cores,
+        int queue_size){
+
+    mjd::Tokenizer tokenizer(keep_characters, non_ascii_mode);
+    mjd::IngestResult result = mjd::ingest_text_files(files,
+                                                      tokenizer,
+                                                      cores,
+                                                      queue_size);
+    if (!result.error.empty()) {
+        Rcpp::stop(result.error);
+    }
+    Rcpp::Rcout << "Indexed " << result.matrix.num_rows() << " documents with "
+                << result.vocabulary.size() << " unique terms..." << std::endl;
+    mjd::prune_vocabulary(result, term_frequency_threshold);
+
+    // triplet form with one based indices for slam::simple_triplet_matrix().
+    const mjd::CSRMatrix& matrix = result.matrix;
+    size_t entries = matrix.num_entries();
+    IntegerVector i(entries);
+    IntegerVector j(entries);
+    NumericVector v(entries);
+    for (int row = 0; row < matrix.num_rows(); ++row) {
+        for (size_t k = matrix.row_pointers[row];
+             k < matrix.row_pointers[row + 1]; ++k) {
+            i[k] = row + 1;
+            j[k] = matrix.columns[k] + 1;
+            v[k] = matrix.values[k];
+        }
+    }
+
+    List to_return(5);
+    to_return[0] = i;
+    to_return[1] = j;
+    to_return[2] = v;
+    to_return[3] = mjd::utf8_character_vector(result.vocabulary.all_terms());
+    to_return[4] = NumericVector(result.term_counts.begin(),
+                                 result.term_counts.end());
+    return to_return;
+}
@@ -0,0 +1,265 @@
+#ifndef SPEEDREADER_MALLET_READER_H
+#define SPEEDREADER_MALLET_READER_H
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <zlib.h>
+
+namespace mjd {
+
+    // A bounded run of lines from a text file, each stored NUL terminated
+    // (without its newline) in one buffer so it can be parsed in place.
+    struct LineChunk {
+        std::string text;
+        std::vector<size_t> starts;
+
+        size_t size() const {
+            return starts.size();
+        }
+
+        const char* line(size_t k) const {
+            return text.data() + starts[k];
+        }
+
+        void clear() {
+            text.clear();
+            starts.clear();
+        }
+    };
+
+    // Reads a gzip compressed (or plain) text file a chunk of lines at a
+    // time, decompressing in process with zlib so the file never has to be
+    // unpacked to disk or held in memory whole.
+    class GzipLineReader {
+    public:
+        GzipLineReader() : file(0) {}
+
+        ~GzipLineReader() {
+            if (file != 0) {
+                gzclose(file);
+            }
+        }
+
+        bool open(const std::string& path, std::string& error) {
+            file = gzopen(path.c_str(), "rb");
+            if (file == 0) {
+                error = "Could not open file: " + path;
+                return false;
+            }
+            gzbuffer(file, 1 << 17);
+            name = path;
+            return true;
+        }
+
+        // Replaces chunk with up to max_lines further lines, returning false
+        // once the file is exhausted (or on error, setting error).
+        bool read_chunk(LineChunk& chunk, size_t max_lines, std::string& error) {
+            chunk.clear();
+            bool in_line = false;
+            while (chunk.size() < max_lines || in_line) {
+                if (gzgets(file, buffer, sizeof(buffer)) == 0) {
+                    int code = Z_OK;
+                    gzerror(file, &code);
+                    if (code != Z_OK && code != Z_STREAM_END) {
+                        error = "Could not decompress file: " + name;
+                        return false;
+                    }
+                    break;
+                }
+                if (!in_line) {
+                    chunk.starts.push_back(chunk.text.size());
+                    in_line = true;
+                }
+                size_t length = std::strlen(buffer);
+                bool ends_line = length > 0 && buffer[length - 1] == '\n';
+                if (ends_line) {
+                    length -= 1;
+                }
+                chunk.text.append(buffer, length);
+                if (ends_line) {
+                    finish_line(chunk);
+                    in_line = false;
+                }
+            }
+            if (in_line) {
+                finish_line(chunk);
+            }
+            return chunk.size() > 0;
+        }
+
+    private:
+        GzipLineReader(const GzipLineReader&);
+        GzipLineReader& operator=(const GzipLineReader&);
+
+        static void finish_line(LineChunk& chunk) {
+            if (!chunk.text.empty() && chunk.text.size() > chunk.starts.back() &&
+                chunk.text[chunk.text.size() - 1] == '\r') {
+                chunk.text.resize(chunk.text.size() - 1);
+            }
+            chunk.text.push_back('\0');
+        }
+
+        gzFile file;
+        std::string name;
+        char buffer[1 << 16];
+    };
+
+    // Splits line at sep (or at any run of blanks if sep is ' '), skipping
+    // empty fields, and stores the start of each field. Fields are left
+    // unterminated; the numeric parsers below stop at the separator.
+    inline void split_fields(const char* line,
+                             char sep,
+                             std::vector<const char*>& fields,
+                             std::vector<size_t>& lengths) {
+        fields.clear();
+        lengths.clear();
+        const char* p = line;
+        while (*p != '\0') {
+            while (*p == sep || (sep == ' ' && *p == '\t')) {
+                ++p;
+            }
+            if (*p == '\0') {
+                break;
+            }
+            const char* start = p;
+            while (*p != '\0' && *p != sep && !(sep == ' ' && *p == '\t')) {
+                ++p;
+            }
+            fields.push_back(start);
+            lengths.push_back(p - start);
+        }
+    }
+
+    // One token of a MALLET Gibbs sampling state, whose lines are
+    // "doc source pos typeindex type topic". The source is whatever name
+    // MALLET was given, so fields are taken from both ends of the line.
+    struct StateToken {
+        long document;
+        long type_index;
+        long topic;
+        const char* type;
+        size_t type_length;
+    };
+
+    inline bool parse_state_line(const char* line,
+                                 StateToken& token,
+                                 std::vector<const char*>& fields,
+                                 std::vector<size_t>& lengths) {
+        split_fields(line, ' ', fields, lengths);
+        size_t n = fields.size();
+        if (n < 5) {
+            return false;
+        }
+        char* end = 0;
+        token.document = std::strtol(fields[0], &end, 10);
+        if (end != fields[0] + lengths[0]) {
+            return false;
+        }
+        token.type_index = std::strtol(fields[n - 3], &end, 10);
+        if (end != fields[n - 3] + lengths[n - 3]) {
+            return false;
+        }
+        token.topic = std::strtol(fields[n - 1], &end, 10);
+        if (end != fields[n - 1] + lengths[n - 1]) {
+            return false;
+        }
+        token.type = fields[n - 2];
+        token.type_length = lengths[n - 2];
+        return token.document >= 0 && token.type_index >= 0 && token.topic >= 0;
+    }
+
+    // Reads the numbers following "#name :" in a state header line, such as
+    // "#alpha : 0.1 0.1 0.1" or "#beta : 0.01".
+    inline std::vector<double> parse_header_values(const char* line) {
+        std::vector<double> values;
+        const char* p = std::strchr(line, ':');
+        if (p == 0) {
+            return values;
+        }
+        ++p;
+        while (true) {
+            char* end = 0;
+            double value = std::strtod(p, &end);
+            if (end == p) {
+                break;
+            }
+            values.push_back(value);
+            p = end;
+        }
+        return values;
+    }
+
+    // The two layouts of MALLET's doc-topics output: (topic, proportion) pairs
+    // sorted by proportion, as older versions write under a "#doc name topic
+    // proportion ..." header, and one proportion per topic, as newer versions
+    // write with no header.
+    enum DocTopicsLayout {
+        DOC_TOPICS_PAIRS = 0,
+        DOC_TOPICS_DENSE = 1
+    };
+
+    // The layout of a doc-topics file, from its first line.
+    inline DocTopicsLayout doc_topics_layout(const char* first_line) {
+        if (std::strncmp(first_line, "#doc", 4) == 0) {
+            return DOC_TOPICS_PAIRS;
+        }
+        return DOC_TOPICS_DENSE;
+    }
+
+    // Parses one line of MALLET's doc-topics output in the given layout, "doc
+    // name" followed by tab separated values, into row[topic * stride].
+    // Returns false if a value does not parse, a topic is out of range, or a
+    // dense line does not have exactly num_topics values.
+    inline bool parse_doc_topics_line(const char* line,
+                                      DocTopicsLayout layout,
+                                      int num_topics,
+                                      double* row,
+                                      size_t stride,
+                                      std::vector<const char*>& fields,
+                                      std::vector<size_t>& lengths) {
+        split_fields(line, '\t', fields, lengths);
+        if (fields.size() < 2) {
+            return false;
+        }
+        size_t num_values = fields.size() - 2;
+        std::vector<double> values(num_values);
+        for (size_t k = 0; k < num_values; ++k) {
+            char* end = 0;
+            values[k] = std::strtod(fields[k + 2], &end);
+            if (end != fields[k + 2] + lengths[k + 2]) {
+                return false;
+            }
+        }
+        if (layout == DOC_TOPICS_DENSE) {
+            if (num_values != size_t(num_topics)) {
+                return false;
+            }
+            for (int topic = 0; topic < num_topics; ++topic) {
+                row[topic * stride] = values[topic];
+            }
+            return true;
+        }
+        if (num_values % 2 != 0) {
+            return false;
+        }
+        for (size_t k = 0; k < num_values; k += 2) {
+            double topic = values[k];
+            if (topic < 0 || topic >= num_topics || topic != long(topic)) {
+                return false;
+            }
+            row[size_t(topic) * stride] = values[k + 1];
+        }
+        return true;
+    }
+
+    // Comment lines (such as the "#doc name topic proportion ..." header) and
+    // blank lines carry no data.
+    inline bool is_data_line(const char* line) {
+        return line[0] != '#' && line[0] != '\0';
+    }
+
+}
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef SPEEDREADER_MATRIX_MERGE_H
+#define SPEEDREADER_MATRIX_MERGE_H
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "CSR_Matrix.h"
+#include "Vocabulary.h"
+
+namespace mjd {
+
+    // Intern every corpus vocabulary into unified (in corpus order) and
+    // return one remap array per corpus giving the unified id of each of its
+    // columns.
+    inline std::vector<std::vector<int> > unify_vocabularies(
+            const std::vector<std::vector<std::string> >& vocabularies,
+            Vocabulary& unified) {
+        std::vector<std::vector<int> > remaps(vocabularies.size());
+        for (size_t c = 0; c < vocabularies.size(); ++c) {
+            remaps[c].resize(vocabularies[c].size());
+            for (size_t k = 0; k < vocabularies[c].size(); ++k) {
+                remaps[c][k] = unified.intern(vocabularies[c][k]);
+            }
+        }
+        return remaps;
+    }
+
+    // Build a CSR matrix from one based (i, j, v) triplets, renumbering
+    // columns through remap. Entries that land in the same row and column,
+    // either because the input repeats them or because two input columns
+    // share a term, are summed. position is scratch space with one entry per
+    // output column, all -1, and is left that way.
+    inline CSRMatrix triplets_to_csr(const int* i,
+                                     const int* j,
+                                     const double* v,
+                                     size_t entries,
+                                     int num_rows,
+                                     const std::vector<int>& remap,
+                                     int num_columns,
+                                     std::vector<int>& position) {
+        // counting sort entries into rows, keeping their order within rows.
+        std::vector<size_t> starts(num_rows + 1, 0);
+        for (size_t k = 0; k < entries; ++k) {
+            starts[i[k]] += 1;
+        }
+        for (int row = 0; row < num_rows; ++row) {
+            starts[row + 1] += starts[row];
+        }
+        std::vector<size_t> order(entries);
+        std::vector<size_t> next(starts.begin(), starts.end() - 1);
+        for (size_t k = 0; k < entries; ++k) {
+            order[next[i[k] - 1]++] = k;
+        }
+
+        CSRMatrix out;
+        out.num_columns = num_columns;
+        out.columns.reserve(entries);
+        out.values.reserve(entries);
+        for (int row = 0; row < num_rows; ++row) {
+            size_t row_start = out.columns.size();
+            for (size_t e = starts[row]; e < starts[row + 1]; ++e) {
+                size_t k = order[e];
+                int column = remap[j[k] - 1];
+                if (position[column] < 0) {
+                    position[column] = out.columns.size();
+                    out.append(column, v[k]);
+                } else {
+                    out.values[position[column]] += v[k];
+                }
+            }
+            for (size_t e = row_start; e < out.columns.size(); ++e) {
+                position[out.columns[e]] = -1;
+            }
+            out.end_row();
+        }
+        return out;
+    }
+
+    // Sort the entries of every row by column id.
+    inline void sort_row_columns(CSRMatrix& matrix) {
+        std::vector<std::pair<int, double> > row;
+        for (int i = 0; i < matrix.num_rows(); ++i) {
+            size_t start = matrix.row_pointers[i];
+            size_t end = matrix.row_pointers[i + 1];
+            row.clear();
+            for (size_t k = start; k < end; ++k) {
+                row.push_back(std::make_pair(matrix.columns[k],
+                                             matrix.values[k]));
+            }
+            std::sort(row.begin(), row.end());
+            for (size_t k = start; k < end; ++k) {
+                matrix.columns[k] = row[k - start].first;
+                matrix.values[k] = row[k - start].second;
+            }
+        }
+    }
+
+    // Column sums of a set of matrices that share the same columns.
+    inline std::vector<double> column_sums(const std::vector<CSRMatrix>& blocks,
+                                           int num_columns) {
+        std::vector<double> sums(num_columns, 0);
+        for (size_t b = 0; b < blocks.size(); ++b) {
+            for (size_t k = 0; k < blocks[b].num_entries(); ++k) {
+                sums[blocks[b].columns[k]] += blocks[b].values[k];
+            }
+        }
+        return sums;
+    }
+
+    // Remap that renumbers columns from most to least frequent, keeping the
+    // original order for ties.
+    inline std::vector<int> frequency_order(const std::vector<double>& sums) {
+        std::vector<int> ordering(sums.size());
+        for (size_t k = 0; k < sums.size(); ++k) {
+            ordering[k] = k;
+        }
+        std::stable_sort(ordering.begin(), ordering.end(), [&sums](int a, int b) {
+            return sums[a] > sums[b];
+        });
+        std::vector<int> remap(sums.size());
+        for (size_t k = 0; k < ordering.size(); ++k) {
+            remap[ordering[k]] = k;
+        }
+        return remap;
+    }
+
+}
+
+#endif
@@ -0,0 +1,90 @@
+// [[Rcpp::plugins(cpp11)]]
+#include <RcppArmadillo.h>
+#include <string>
+#include "Dice_Sweep.h"
+#include "Parallel.h"
+#include "Vocabulary.h"
+//[[Rcpp::depends(RcppArmadillo)]]
+using namespace Rcpp;
+
+namespace mjd {
+    // Dice coefficient matrices (one row per pair, one column per n-gram
+    // size) from the distinct and shared n-gram counts of each pair.
+    List dice_coefficient_matrices(const std::vector<DiceCounts>& counts,
+                                   int number_of_sizes) {
+        int number_of_pairs = counts.size();
+        arma::mat dice_coefficients = arma::zeros(number_of_pairs, number_of_sizes);
+        arma::mat both_in_a = arma::zeros(number_of_pairs, number_of_sizes);
+        arma::mat both_in_b = arma::zeros(number_of_pairs, number_of_sizes);
+        arma::mat ngrams_a = arma::zeros(number_of_pairs, number_of_sizes);
+        arma::mat ngrams_b = arma::zeros(number_of_pairs, number_of_sizes);
+        arma::mat both = arma::zeros(number_of_pairs, number_of_sizes);
+        for (int k = 0; k < number_of_pairs; ++k) {
+            for (int s = 0; s < number_of_sizes; ++s) {
+                double in_a = counts[k].ngrams_a[s];
+                double in_b = counts[k].ngrams_b[s];
+                double in_both = counts[k].both[s];
+                dice_coefficients(k, s) = (2 * in_both)/(in_a + in_b);
+                both_in_a(k, s) = in_both/in_a;
+                both_in_b(k, s) = in_both/in_b;
+                ngrams_a(k, s) = in_a;
+                ngrams_b(k, s) = in_b;
+                both(k, s) = in_both;
+            }
+        }
+
+        List to_return(6);
+        to_return[0] = dice_coefficients;
+        to_return[1] = both_in_a;
+        to_return[2] = both_in_b;
+        to_return[3] = ngrams_a;
+        to_return[4] = ngrams_b;
+        to_return[5] = both;
+        return to_return;
+    }
+}
+
+// Dice coefficients for every n-gram size, for each pair of token vectors
+// (documents_a[[k]], documents_b[[k]]). Each pair is interned to ids and all
+// sizes are computed from a single suffix array sweep, with pairs spread
+// over threads. Returns matrices with one row per pair and one column per
+// n-gram size.
+// [[Rcpp::export]]
+List Multi_Dice_Coefficients(List documents_a,
+                             List documents_b,
+                             std::vector<int> ngram_sizes,
+                             int cores){
+
+    int number_of_pairs = documents_a.size();
+    if (documents_b.size() != size_t(number_of_pairs)) {
+        Rcpp::stop("There must be the same number of documents in each list.");
+    }
+    std::vector<std::vector<std::string> > tokens_a(number_of_pairs);
+    std::vector<std::vector<std::string> > tokens_b(number_of_pairs);
+    for (int k = 0; k < number_of_pairs; ++k) {
+        tokens_a[k] = Rcpp::as<std::vector<std::string> >(documents_a[k]);
+        tokens_b[k] = Rcpp::as<std::vector<std::string> >(documents_b[k]);
+    }
+
+    int number_of_sizes = ngram_sizes.size();
+    std::vector<mjd::DiceCounts> counts(number_of_pairs);
+    mjd::parallel_for(number_of_pairs, cores, [&](int start, int end, int t) {
+        for (int k = start; k < end; ++k) {
+            mjd::Vocabulary vocabulary;
+            std::vector<int> a(tokens_a[k].size());
+            std::vector<int> b(tokens_b[k].size());
+            for (size_t i = 0; i < a.size(); ++i) {
+                a[i] = vocabulary.intern(tokens_a[k][i]);
+            }
+            for (size_t i = 0; i < b.size(); ++i) {
+                b[i] = vocabulary.intern(tokens_b[k][i]);
+            }
+            std::vector<std::string>().swap(tokens_a[k]);
+            std::vector<std::string>().swap(tokens_b[k]);
+            counts[k] = mjd::multi_dice_counts(a, b, vocabulary.size(),
+                                               ngram_sizes);
+        }
+    });
+
+    return mjd::dice_coefficient_matrices(counts, number_of_sizes);
+}
@@ -0,0 +1,111 @@
+#ifndef SPEEDREADER_NGRAM_EXTRACTOR_H
+#define SPEEDREADER_NGRAM_EXTRACTOR_H
+
+#include <string>
+#include <vector>
+#include <algorithm>
+
+namespace mjd {
+
+    // The tokens of one document stored back to back in a single buffer.
+    // Token k occupies text[offsets[k], offsets[k + 1]) and blocked[k] is
+    // non-zero if any n-gram containing it should be dropped (punctuation
+    // or numerals when those are being removed).
+    struct TokenArena {
+        std::string text;
+        std::vector<size_t> offsets;
+        std::vector<char> blocked;
+
+        TokenArena() : offsets(1, 0) {}
+
+        int num_tokens() const {
+            return offsets.size() - 1;
+        }
+
+        void append(const std::string& token, bool is_blocked) {
+            text.append(token);
+            offsets.push_back(text.size());
+            blocked.push_back(is_blocked);
+        }
+    };
+
+    // All n-grams of a single length extracted from one document. Every
+    // n-gram is NUL terminated in text and starts at starts[k], so they can
+    // be handed to R without another copy.
+    struct NGramArena {
+        std::string text;
+        std::vector<size_t> starts;
+
+        size_t size() const {
+            return starts.size();
+        }
+
+        const char* ngram(size_t k) const {
+            return text.data() + starts[k];
+        }
+    };
+
+    // Extract n-grams of every length in ngram_lengths from a document in a
+    // single sliding window pass, joining tokens with "_". A window is kept
+    // only if the prefix sum of blocked flags does not change across it.
+    // Sizes are counted before anything is written so that each output arena
+    // is allocated exactly once. out[l] is left empty if the document is
+    // shorter than ngram_lengths[l].
+    inline void extract_ngrams(const TokenArena& document,
+                               const std::vector<int>& ngram_lengths,
+                               std::vector<NGramArena>& out) {
+        int num_tokens = document.num_tokens();
+        int num_lengths = ngram_lengths.size();
+        out.assign(num_lengths, NGramArena());
+
+        std::vector<int> blocked_before(num_tokens + 1, 0);
+        for (int k = 0; k < num_tokens; ++k) {
+            blocked_before[k + 1] = blocked_before[k] + document.blocked[k];
+        }
+        const std::vector<size_t>& offsets = document.offsets;
+
+        // first pass: count the n-grams and bytes each length will need.
+        std::vector<size_t> counts(num_lengths, 0);
+        std::vector<size_t> bytes(num_lengths, 0);
+        for (int start = 0; start < num_tokens; ++start) {
+            for (int l = 0; l < num_lengths; ++l) {
+                int end = start + ngram_lengths[l];
+                if (end > num_tokens ||
+                    blocked_before[end] != blocked_before[start]) {
+                    continue;
+                }
+                counts[l] += 1;
+                // the tokens, n - 1 separators and a terminating NUL.
+                bytes[l] += offsets[end] - offsets[start] + ngram_lengths[l];
+            }
+        }
+        for (int l = 0; l < num_lengths; ++l) {
+            out[l].starts.reserve(counts[l]);
+            out[l].text.reserve(bytes[l]);
+        }
+
+        // second pass: write them out.
+        for (int start = 0; start < num_tokens; ++start) {
+            for (int l = 0; l < num_lengths; ++l) {
+                int end = start + ngram_lengths[l];
+                if (end > num_tokens ||
+                    blocked_before[end] != blocked_before[start]) {
+                    continue;
+                }
+                NGramArena& arena = out[l];
+                arena.starts.push_back(arena.text.size());
+                for (int k = start; k < end; ++k) {
+                    if (k > start) {
+                        arena.text.push_back('_');
+                    }
+                    arena.text.append(document.text, offsets[k],
+                                      offsets[k + 1] - offsets[k]);
+                }
+                arena.text.push_back('\0');
+            }
+        }
+    }
+
+}
+
+#endif
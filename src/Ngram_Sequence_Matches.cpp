@@ -0,0 +1,85 @@
+// [[Rcpp::plugins(cpp11)]]
+#include <RcppArmadillo.h>
+#include <string>
+#include "Suffix_Automaton.h"
+#include "Vocabulary.h"
+//[[Rcpp::depends(RcppArmadillo)]]
+using namespace Rcpp;
+
+namespace mjd {
+    // lengths of the runs of matches (value == 1) or non-matches in a mask,
+    // or a single zero if there are none. As ngram_sequence_matching() always
+    // has, a run that is still open at the end of the mask is not counted.
+    NumericVector run_lengths(const std::vector<double>& mask, double value) {
+        std::vector<double> runs;
+        double current = 0;
+        for (size_t k = 0; k < mask.size(); ++k) {
+            if (mask[k] == value) {
+                current += 1;
+            } else if (current != 0) {
+                runs.push_back(current);
+                current = 0;
+            }
+        }
+        if (runs.empty()) {
+            runs.push_back(0);
+        }
+        return NumericVector(runs.begin(), runs.end());
+    }
+}
+
+// Builds suffix automata over each document's token ids once and streams the
+// other document through them, giving match masks for every n-gram size in
+// linear time. For each size returns the masks for both documents and the
+// lengths of their runs of matches and non-matches. Also returns the maximal
+// matching blocks of document_1 in document_2 (one based starts in each, and
+// lengths) that are at least minimum_block_length tokens long.
+// [[Rcpp::export]]
+List Ngram_Sequence_Matches(std::vector<std::string> document_1,
+                            std::vector<std::string> document_2,
+                            std::vector<int> ngram_sizes,
+                            int minimum_block_length){
+
+    mjd::Vocabulary vocabulary;
+    std::vector<int> a(document_1.size());
+    std::vector<int> b(document_2.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        a[i] = vocabulary.intern(document_1[i]);
+    }
+    for (size_t i = 0; i < b.size(); ++i) {
+        b[i] = vocabulary.intern(document_2[i]);
+    }
+    mjd::SequenceMatcher matcher(a, b);
+
+    List size_matches(ngram_sizes.size());
+    for (size_t s = 0; s < ngram_sizes.size(); ++s) {
+        std::vector<double> which_a_in_b = matcher.which_a_in_b(ngram_sizes[s]);
+        std::vector<double> which_b_in_a = matcher.which_b_in_a(ngram_sizes[s]);
+        List current(6);
+        current[0] = NumericVector(which_a_in_b.begin(), which_a_in_b.end());
+        current[1] = NumericVector(which_b_in_a.begin(), which_b_in_a.end());
+        current[2] = mjd::run_lengths(which_a_in_b, 1);
+        current[3] = mjd::run_lengths(which_b_in_a, 1);
+        current[4] = mjd::run_lengths(which_a_in_b, 0);
+        current[5] = mjd::run_lengths(which_b_in_a, 0);
+        size_matches[s] = current;
+    }
+
+    std::vector<int> a_starts;
+    std::vector<int> b_starts;
+    std::vector<int> lengths;
+    matcher.matching_blocks(minimum_block_length, a_starts, b_starts, lengths);
+    for (size_t k = 0; k < lengths.size(); ++k) {
+        a_starts[k] += 1;
+        b_starts[k] += 1;
+    }
+    List blocks(3);
+    blocks[0] = IntegerVector(a_starts.begin(), a_starts.end());
+    blocks[1] = IntegerVector(b_starts.begin(), b_starts.end());
+    blocks[2] = IntegerVector(lengths.begin(), lengths.end());
+
+    List to_return(2);
+    to_return[0] = size_matches;
+    to_return[1] = blocks;
+    return to_return;
+}
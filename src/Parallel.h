@@ -0,0 +1,67 @@
+#ifndef SPEEDREADER_PARALLEL_H
+#define SPEEDREADER_PARALLEL_H
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+namespace mjd {
+
+    // resolve the number of worker threads to use. A value of less than one
+    // means "use all available hardware threads".
+    inline int resolve_cores(int cores, int work_items) {
+        if (cores < 1) {
+            cores = std::thread::hardware_concurrency();
+            if (cores < 1) {
+                cores = 1;
+            }
+        }
+        if (cores > work_items) {
+            cores = work_items;
+        }
+        if (cores < 1) {
+            cores = 1;
+        }
+        return cores;
+    }
+
+    // Split [0, n) into contiguous ranges, one per thread, and call
+    // f(start, end, thread_index) on each. Ranges are handed out in order so
+    // thread t always sees items that come before those of thread t + 1, which
+    // lets callers merge per-thread results deterministically. The R API must
+    // never be touched from inside f.
+    template <typename F>
+    void parallel_for(int n, int cores, F f) {
+        int threads = resolve_cores(cores, n);
+        if (threads <= 1) {
+            f(0, n, 0);
+            return;
+        }
+        std::vector<std::thread> workers;
+        int chunk = (n + threads - 1) / threads;
+        for (int t = 0; t < threads; ++t) {
+            int start = t * chunk;
+            int end = std::min(n, start + chunk);
+            if (start >= end) {
+                break;
+            }
+            workers.push_back(std::thread(f, start, end, t));
+        }
+        for (size_t t = 0; t < workers.size(); ++t) {
+            workers[t].join();
+        }
+    }
+
+    // number of ranges parallel_for() will actually create for n items.
+    inline int parallel_ranges(int n, int cores) {
+        int threads = resolve_cores(cores, n);
+        if (threads <= 1) {
+            return 1;
+        }
+        int chunk = (n + threads - 1) / threads;
+        return (n + chunk - 1) / chunk;
+    }
+
+}
+
+#endif
@@ -0,0 +1,77 @@
+// [[Rcpp::plugins(cpp11)]]
+#include <RcppArmadillo.h>
+#include <string>
+#include <utility>
+#include "Term_Count_Merge.h"
+#include "Telemetry.h"
+//[[Rcpp::depends(RcppArmadillo)]]
+using namespace Rcpp;
+
+namespace mjd {
+    CharacterVector utf8_character_vector(const std::vector<std::string>& v);
+}
+
+// Counts the terms in one block of documents (with optional matching counts,
+// or an empty list), independently of every other block. Returns the terms
+// sorted, their counts, and where each was first seen, as a run for
+// Merge_Term_Count_Runs().
+// [[Rcpp::export]]
+List Count_Block_Terms(List document_term_vector_list,
+                       List document_term_count_list,
+                       int block){
+
+    bool using_counts = document_term_count_list.size() > 0;
+    mjd::Vocabulary vocabulary;
+    std::vector<double> counts;
+    int num_docs = document_term_vector_list.size();
+    for (int i = 0; i < num_docs; ++i) {
+        std::vector<std::string> terms =
+            Rcpp::as<std::vector<std::string> >(document_term_vector_list[i]);
+        NumericVector weights;
+        if (using_counts) {
+            weights = document_term_count_list[i];
+            if (int(weights.size()) != int(terms.size())) {
+                Rcpp::stop("Document " + std::to_string(i + 1) + " has a different number of terms and counts.");
+            }
+        }
+        for (size_t k = 0; k < terms.size(); ++k) {
+            int id = vocabulary.intern(terms[k]);
+            if (id == int(counts.size())) {
+                counts.push_back(0);
+            }
+            counts[id] += using_counts ? weights[k] : 1;
+        }
+    }
+
+    mjd::TermCountRun run = mjd::sorted_term_counts(vocabulary, counts, block);
+    List to_return(3);
+    to_return[0] = mjd::utf8_character_vector(run.terms);
+    to_return[1] = NumericVector(run.counts.begin(), run.counts.end());
+    to_return[2] = NumericVector(run.first.begin(), run.first.end());
+    return to_return;
+}
+
+// Merges runs from Count_Block_Terms() into one sorted run with a parallel
+// tree reduction.
+// [[Rcpp::export]]
+List Merge_Term_Count_Runs(List runs,
+                           int cores){
+
+    mjd::PhaseTimer merging("Merge_Term_Count_Runs.merging");
+    int num_runs = runs.size();
+    std::vector<mjd::TermCountRun> local(num_runs);
+    for (int r = 0; r < num_runs; ++r) {
+        List run = runs[r];
+        local[r].terms = Rcpp::as<std::vector<std::string> >(run[0]);
+        local[r].counts = Rcpp::as<std::vector<double> >(run[1]);
+        local[r].first = Rcpp::as<std::vector<double> >(run[2]);
+    }
+    mjd::TermCountRun merged = mjd::tree_merge_term_counts(std::move(local), cores);
+    mjd::telemetry().counter("Merge_Term_Count_Runs.runs") += runs.size();
+
+    List to_return(3);
+    to_return[0] = mjd::utf8_character_vector(merged.terms);
+    to_return[1] = NumericVector(merged.counts.begin(), merged.counts.end());
+    to_return[2] = NumericVector(merged.first.begin(), merged.first.end());
+    return to_return;
+}
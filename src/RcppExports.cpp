@@ -6,6 +6,54 @@
 
 using namespace Rcpp;
 
+// Generate_Zipf_Corpus
+List Generate_Zipf_Corpus(int num_documents, int vocabulary_size, double exponent, double mean_length, double length_sd, double duplicate_rate, double edit_rate, double seed);
+RcppExport SEXP _SpeedReader_Generate_Zipf_Corpus(SEXP num_documentsSEXP, SEXP vocabulary_sizeSEXP, SEXP exponentSEXP, SEXP mean_lengthSEXP, SEXP length_sdSEXP, SEXP duplicate_rateSEXP, SEXP edit_rateSEXP, SEXP seedSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< int >::type num_documents(num_documentsSEXP);
+    Rcpp::traits::input_parameter< int >::type vocabulary_size(vocabulary_sizeSEXP);
+    Rcpp::traits::input_parameter< double >::type exponent(exponentSEXP);
+    Rcpp::traits::input_parameter< double >::type mean_length(mean_lengthSEXP);
+    Rcpp::traits::input_parameter< double >::type length_sd(length_sdSEXP);
+    Rcpp::traits::input_parameter< double >::type duplicate_rate(duplicate_rateSEXP);
+    Rcpp::traits::input_parameter< double >::type edit_rate(edit_rateSEXP);
+    Rcpp::traits::input_parameter< double >::type seed(seedSEXP);
+    rcpp_result_gen = Rcpp::wrap(Generate_Zipf_Corpus(num_documents, vocabulary_size, exponent, mean_length, length_sd, duplicate_rate, edit_rate, seed));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Benchmark_Clock
+double Benchmark_Clock();
+RcppExport SEXP _SpeedReader_Benchmark_Clock() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(Benchmark_Clock());
+    return rcpp_result_gen;
+END_RCPP
+}
+// Reset_Peak_Resident_Memory
+bool Reset_Peak_Resident_Memory();
+RcppExport SEXP _SpeedReader_Reset_Peak_Resident_Memory() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(Reset_Peak_Resident_Memory());
+    return rcpp_result_gen;
+END_RCPP
+}
+// Peak_Resident_Memory
+double Peak_Resident_Memory();
+RcppExport SEXP _SpeedReader_Peak_Resident_Memory() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(Peak_Resident_Memory());
+    return rcpp_result_gen;
+END_RCPP
+}
 // calculate_ACMI_contribution
 arma::vec calculate_ACMI_contribution(double dist_sum, arma::vec colsums, arma::vec rowsums, int num_cols, arma::vec column_contributions, arma::vec row_index_counts, arma::mat joint, int total_non_zeros, double full_MI);
 RcppExport SEXP _SpeedReader_calculate_ACMI_contribution(SEXP dist_sumSEXP, SEXP colsumsSEXP, SEXP rowsumsSEXP, SEXP num_colsSEXP, SEXP column_contributionsSEXP, SEXP row_index_countsSEXP, SEXP jointSEXP, SEXP total_non_zerosSEXP, SEXP full_MISEXP) {
@@ -43,24 +91,26 @@ BEGIN_RCPP
 END_RCPP
 }
 // calculate_document_frequency
-arma::vec calculate_document_frequency(arma::mat document_word_matrix);
-RcppExport SEXP _SpeedReader_calculate_document_frequency(SEXP document_word_matrixSEXP) {
+arma::vec calculate_document_frequency(const arma::mat& document_word_matrix, int cores);
+RcppExport SEXP _SpeedReader_calculate_document_frequency(SEXP document_word_matrixSEXP, SEXP coresSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< arma::mat >::type document_word_matrix(document_word_matrixSEXP);
-    rcpp_result_gen = Rcpp::wrap(calculate_document_frequency(document_word_matrix));
+    Rcpp::traits::input_parameter< const arma::mat& >::type document_word_matrix(document_word_matrixSEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    rcpp_result_gen = Rcpp::wrap(calculate_document_frequency(document_word_matrix, cores));
     return rcpp_result_gen;
 END_RCPP
 }
 // Calculate_TFIDF
-List Calculate_TFIDF(arma::mat document_word_matrix);
-RcppExport SEXP _SpeedReader_Calculate_TFIDF(SEXP document_word_matrixSEXP) {
+List Calculate_TFIDF(const arma::mat& document_word_matrix, int cores);
+RcppExport SEXP _SpeedReader_Calculate_TFIDF(SEXP document_word_matrixSEXP, SEXP coresSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< arma::mat >::type document_word_matrix(document_word_matrixSEXP);
-    rcpp_result_gen = Rcpp::wrap(Calculate_TFIDF(document_word_matrix));
+    Rcpp::traits::input_parameter< const arma::mat& >::type document_word_matrix(document_word_matrixSEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    rcpp_result_gen = Rcpp::wrap(Calculate_TFIDF(document_word_matrix, cores));
     return rcpp_result_gen;
 END_RCPP
 }
@@ -76,16 +126,117 @@ BEGIN_RCPP
 END_RCPP
 }
 // Combine_Document_Term_Matrices
-List Combine_Document_Term_Matrices(List document_word_matrix_list, List vocabularies, std::vector<std::string> unique_words, int number_of_corpora);
-RcppExport SEXP _SpeedReader_Combine_Document_Term_Matrices(SEXP document_word_matrix_listSEXP, SEXP vocabulariesSEXP, SEXP unique_wordsSEXP, SEXP number_of_corporaSEXP) {
+List Combine_Document_Term_Matrices(List document_term_matrix_list, List vocabularies, bool sort_columns, int cores);
+RcppExport SEXP _SpeedReader_Combine_Document_Term_Matrices(SEXP document_term_matrix_listSEXP, SEXP vocabulariesSEXP, SEXP sort_columnsSEXP, SEXP coresSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< List >::type document_word_matrix_list(document_word_matrix_listSEXP);
+    Rcpp::traits::input_parameter< List >::type document_term_matrix_list(document_term_matrix_listSEXP);
     Rcpp::traits::input_parameter< List >::type vocabularies(vocabulariesSEXP);
-    Rcpp::traits::input_parameter< std::vector<std::string> >::type unique_words(unique_wordsSEXP);
-    Rcpp::traits::input_parameter< int >::type number_of_corpora(number_of_corporaSEXP);
-    rcpp_result_gen = Rcpp::wrap(Combine_Document_Term_Matrices(document_word_matrix_list, vocabularies, unique_words, number_of_corpora));
+    Rcpp::traits::input_parameter< bool >::type sort_columns(sort_columnsSEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    rcpp_result_gen = Rcpp::wrap(Combine_Document_Term_Matrices(document_term_matrix_list, vocabularies, sort_columns, cores));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Create_Corpus
+SEXP Create_Corpus(List documents, int cores, bool frequency_ranked);
+RcppExport SEXP _SpeedReader_Create_Corpus(SEXP documentsSEXP, SEXP coresSEXP, SEXP frequency_rankedSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type documents(documentsSEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    Rcpp::traits::input_parameter< bool >::type frequency_ranked(frequency_rankedSEXP);
+    rcpp_result_gen = Rcpp::wrap(Create_Corpus(documents, cores, frequency_ranked));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Corpus_Info
+List Corpus_Info(SEXP corpus);
+RcppExport SEXP _SpeedReader_Corpus_Info(SEXP corpusSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type corpus(corpusSEXP);
+    rcpp_result_gen = Rcpp::wrap(Corpus_Info(corpus));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Corpus_Vocabulary
+CharacterVector Corpus_Vocabulary(SEXP corpus);
+RcppExport SEXP _SpeedReader_Corpus_Vocabulary(SEXP corpusSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type corpus(corpusSEXP);
+    rcpp_result_gen = Rcpp::wrap(Corpus_Vocabulary(corpus));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Corpus_Documents
+List Corpus_Documents(SEXP corpus, std::vector<int> documents);
+RcppExport SEXP _SpeedReader_Corpus_Documents(SEXP corpusSEXP, SEXP documentsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type corpus(corpusSEXP);
+    Rcpp::traits::input_parameter< std::vector<int> >::type documents(documentsSEXP);
+    rcpp_result_gen = Rcpp::wrap(Corpus_Documents(corpus, documents));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Corpus_Count_Words
+List Corpus_Count_Words(SEXP corpus, int cores);
+RcppExport SEXP _SpeedReader_Corpus_Count_Words(SEXP corpusSEXP, SEXP coresSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type corpus(corpusSEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    rcpp_result_gen = Rcpp::wrap(Corpus_Count_Words(corpus, cores));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Corpus_Document_Term_Matrix
+List Corpus_Document_Term_Matrix(SEXP corpus, std::vector<std::string> vocabulary, int cores);
+RcppExport SEXP _SpeedReader_Corpus_Document_Term_Matrix(SEXP corpusSEXP, SEXP vocabularySEXP, SEXP coresSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type corpus(corpusSEXP);
+    Rcpp::traits::input_parameter< std::vector<std::string> >::type vocabulary(vocabularySEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    rcpp_result_gen = Rcpp::wrap(Corpus_Document_Term_Matrix(corpus, vocabulary, cores));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Corpus_Sequence_Comparison
+arma::mat Corpus_Sequence_Comparison(SEXP corpus, arma::mat comparison_inds, int ngram_length, int cores);
+RcppExport SEXP _SpeedReader_Corpus_Sequence_Comparison(SEXP corpusSEXP, SEXP comparison_indsSEXP, SEXP ngram_lengthSEXP, SEXP coresSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type corpus(corpusSEXP);
+    Rcpp::traits::input_parameter< arma::mat >::type comparison_inds(comparison_indsSEXP);
+    Rcpp::traits::input_parameter< int >::type ngram_length(ngram_lengthSEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    rcpp_result_gen = Rcpp::wrap(Corpus_Sequence_Comparison(corpus, comparison_inds, ngram_length, cores));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Corpus_Dice_Coefficients
+List Corpus_Dice_Coefficients(SEXP corpus, std::vector<int> documents_a, std::vector<int> documents_b, std::vector<int> ngram_sizes, int cores);
+RcppExport SEXP _SpeedReader_Corpus_Dice_Coefficients(SEXP corpusSEXP, SEXP documents_aSEXP, SEXP documents_bSEXP, SEXP ngram_sizesSEXP, SEXP coresSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type corpus(corpusSEXP);
+    Rcpp::traits::input_parameter< std::vector<int> >::type documents_a(documents_aSEXP);
+    Rcpp::traits::input_parameter< std::vector<int> >::type documents_b(documents_bSEXP);
+    Rcpp::traits::input_parameter< std::vector<int> >::type ngram_sizes(ngram_sizesSEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    rcpp_result_gen = Rcpp::wrap(Corpus_Dice_Coefficients(corpus, documents_a, documents_b, ngram_sizes, cores));
     return rcpp_result_gen;
 END_RCPP
 }
@@ -110,6 +261,230 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// Create_CSR_Store
+void Create_CSR_Store(std::string directory, std::vector<std::string> vocabulary, int value_type);
+RcppExport SEXP _SpeedReader_Create_CSR_Store(SEXP directorySEXP, SEXP vocabularySEXP, SEXP value_typeSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::string >::type directory(directorySEXP);
+    Rcpp::traits::input_parameter< std::vector<std::string> >::type vocabulary(vocabularySEXP);
+    Rcpp::traits::input_parameter< int >::type value_type(value_typeSEXP);
+    Create_CSR_Store(directory, vocabulary, value_type);
+    return R_NilValue;
+END_RCPP
+}
+// Append_CSR_Store
+void Append_CSR_Store(std::string directory, IntegerVector i, IntegerVector j, NumericVector v, int num_rows);
+RcppExport SEXP _SpeedReader_Append_CSR_Store(SEXP directorySEXP, SEXP iSEXP, SEXP jSEXP, SEXP vSEXP, SEXP num_rowsSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::string >::type directory(directorySEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type i(iSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type j(jSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type v(vSEXP);
+    Rcpp::traits::input_parameter< int >::type num_rows(num_rowsSEXP);
+    Append_CSR_Store(directory, i, j, v, num_rows);
+    return R_NilValue;
+END_RCPP
+}
+// CSR_Store_Info
+List CSR_Store_Info(std::string directory);
+RcppExport SEXP _SpeedReader_CSR_Store_Info(SEXP directorySEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::string >::type directory(directorySEXP);
+    rcpp_result_gen = Rcpp::wrap(CSR_Store_Info(directory));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Verify_CSR_Store
+bool Verify_CSR_Store(std::string directory);
+RcppExport SEXP _SpeedReader_Verify_CSR_Store(SEXP directorySEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::string >::type directory(directorySEXP);
+    rcpp_result_gen = Rcpp::wrap(Verify_CSR_Store(directory));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Extend_CSR_Store_Vocabulary
+void Extend_CSR_Store_Vocabulary(std::string directory, std::vector<std::string> terms);
+RcppExport SEXP _SpeedReader_Extend_CSR_Store_Vocabulary(SEXP directorySEXP, SEXP termsSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::string >::type directory(directorySEXP);
+    Rcpp::traits::input_parameter< std::vector<std::string> >::type terms(termsSEXP);
+    Extend_CSR_Store_Vocabulary(directory, terms);
+    return R_NilValue;
+END_RCPP
+}
+// Rebuild_CSR_Store_Statistics
+void Rebuild_CSR_Store_Statistics(std::string directory, int cores);
+RcppExport SEXP _SpeedReader_Rebuild_CSR_Store_Statistics(SEXP directorySEXP, SEXP coresSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::string >::type directory(directorySEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    Rebuild_CSR_Store_Statistics(directory, cores);
+    return R_NilValue;
+END_RCPP
+}
+// Slice_CSR_Store
+List Slice_CSR_Store(std::string directory, IntegerVector rows, IntegerVector columns);
+RcppExport SEXP _SpeedReader_Slice_CSR_Store(SEXP directorySEXP, SEXP rowsSEXP, SEXP columnsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::string >::type directory(directorySEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type rows(rowsSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type columns(columnsSEXP);
+    rcpp_result_gen = Rcpp::wrap(Slice_CSR_Store(directory, rows, columns));
+    return rcpp_result_gen;
+END_RCPP
+}
+// CSR_Store_Summary
+List CSR_Store_Summary(std::string directory, int cores);
+RcppExport SEXP _SpeedReader_CSR_Store_Summary(SEXP directorySEXP, SEXP coresSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::string >::type directory(directorySEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    rcpp_result_gen = Rcpp::wrap(CSR_Store_Summary(directory, cores));
+    return rcpp_result_gen;
+END_RCPP
+}
+// CSR_Store_Group_Column_Sums
+List CSR_Store_Group_Column_Sums(std::string directory, IntegerVector groups, int first_row, int cores);
+RcppExport SEXP _SpeedReader_CSR_Store_Group_Column_Sums(SEXP directorySEXP, SEXP groupsSEXP, SEXP first_rowSEXP, SEXP coresSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::string >::type directory(directorySEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type groups(groupsSEXP);
+    Rcpp::traits::input_parameter< int >::type first_row(first_rowSEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    rcpp_result_gen = Rcpp::wrap(CSR_Store_Group_Column_Sums(directory, groups, first_row, cores));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Distinct_Words
+List Distinct_Words(List word_vector_list, double threshold, int cores);
+RcppExport SEXP _SpeedReader_Distinct_Words(SEXP word_vector_listSEXP, SEXP thresholdSEXP, SEXP coresSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type word_vector_list(word_vector_listSEXP);
+    Rcpp::traits::input_parameter< double >::type threshold(thresholdSEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    rcpp_result_gen = Rcpp::wrap(Distinct_Words(word_vector_list, threshold, cores));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Frequency_Threshold
+LogicalVector Frequency_Threshold(std::vector<std::string> word_vector, double threshold);
+RcppExport SEXP _SpeedReader_Frequency_Threshold(SEXP word_vectorSEXP, SEXP thresholdSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::vector<std::string> >::type word_vector(word_vectorSEXP);
+    Rcpp::traits::input_parameter< double >::type threshold(thresholdSEXP);
+    rcpp_result_gen = Rcpp::wrap(Frequency_Threshold(word_vector, threshold));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Write_Document_Term_Block
+void Write_Document_Term_Block(List document_term_vector_list, List document_term_count_list, std::string file);
+RcppExport SEXP _SpeedReader_Write_Document_Term_Block(SEXP document_term_vector_listSEXP, SEXP document_term_count_listSEXP, SEXP fileSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type document_term_vector_list(document_term_vector_listSEXP);
+    Rcpp::traits::input_parameter< List >::type document_term_count_list(document_term_count_listSEXP);
+    Rcpp::traits::input_parameter< std::string >::type file(fileSEXP);
+    Write_Document_Term_Block(document_term_vector_list, document_term_count_list, file);
+    return R_NilValue;
+END_RCPP
+}
+// Read_Document_Term_Block
+List Read_Document_Term_Block(std::string file);
+RcppExport SEXP _SpeedReader_Read_Document_Term_Block(SEXP fileSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::string >::type file(fileSEXP);
+    rcpp_result_gen = Rcpp::wrap(Read_Document_Term_Block(file));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Block_Count_Words
+List Block_Count_Words(std::vector<std::string> files, int cores);
+RcppExport SEXP _SpeedReader_Block_Count_Words(SEXP filesSEXP, SEXP coresSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::vector<std::string> >::type files(filesSEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    rcpp_result_gen = Rcpp::wrap(Block_Count_Words(files, cores));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Block_Document_Term_Matrix
+List Block_Document_Term_Matrix(std::vector<std::string> files, std::vector<std::string> vocabulary, int cores);
+RcppExport SEXP _SpeedReader_Block_Document_Term_Matrix(SEXP filesSEXP, SEXP vocabularySEXP, SEXP coresSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::vector<std::string> >::type files(filesSEXP);
+    Rcpp::traits::input_parameter< std::vector<std::string> >::type vocabulary(vocabularySEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    rcpp_result_gen = Rcpp::wrap(Block_Document_Term_Matrix(files, vocabulary, cores));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Text_Duplicate_Clusters
+List Text_Duplicate_Clusters(std::vector<std::string> text, int shingle_length, int max_distance, int cores);
+RcppExport SEXP _SpeedReader_Text_Duplicate_Clusters(SEXP textSEXP, SEXP shingle_lengthSEXP, SEXP max_distanceSEXP, SEXP coresSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::vector<std::string> >::type text(textSEXP);
+    Rcpp::traits::input_parameter< int >::type shingle_length(shingle_lengthSEXP);
+    Rcpp::traits::input_parameter< int >::type max_distance(max_distanceSEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    rcpp_result_gen = Rcpp::wrap(Text_Duplicate_Clusters(text, shingle_length, max_distance, cores));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Token_Duplicate_Clusters
+List Token_Duplicate_Clusters(List documents, int shingle_length, int max_distance, int cores);
+RcppExport SEXP _SpeedReader_Token_Duplicate_Clusters(SEXP documentsSEXP, SEXP shingle_lengthSEXP, SEXP max_distanceSEXP, SEXP coresSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type documents(documentsSEXP);
+    Rcpp::traits::input_parameter< int >::type shingle_length(shingle_lengthSEXP);
+    Rcpp::traits::input_parameter< int >::type max_distance(max_distanceSEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    rcpp_result_gen = Rcpp::wrap(Token_Duplicate_Clusters(documents, shingle_length, max_distance, cores));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Corpus_Duplicate_Clusters
+List Corpus_Duplicate_Clusters(SEXP corpus, int shingle_length, int max_distance, int cores);
+RcppExport SEXP _SpeedReader_Corpus_Duplicate_Clusters(SEXP corpusSEXP, SEXP shingle_lengthSEXP, SEXP max_distanceSEXP, SEXP coresSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type corpus(corpusSEXP);
+    Rcpp::traits::input_parameter< int >::type shingle_length(shingle_lengthSEXP);
+    Rcpp::traits::input_parameter< int >::type max_distance(max_distanceSEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    rcpp_result_gen = Rcpp::wrap(Corpus_Duplicate_Clusters(corpus, shingle_length, max_distance, cores));
+    return rcpp_result_gen;
+END_RCPP
+}
 // Efficient_Block_Sequential_String_Set_Hash_Comparison
 arma::mat Efficient_Block_Sequential_String_Set_Hash_Comparison(List documents, int num_docs, arma::mat comparison_inds, int ngram_length, bool ignore_documents, arma::vec to_ignore);
 RcppExport SEXP _SpeedReader_Efficient_Block_Sequential_String_Set_Hash_Comparison(SEXP documentsSEXP, SEXP num_docsSEXP, SEXP comparison_indsSEXP, SEXP ngram_lengthSEXP, SEXP ignore_documentsSEXP, SEXP to_ignoreSEXP) {
@@ -158,6 +533,23 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// Extract_NGrams
+List Extract_NGrams(List token_list, List punctuation_list, List numeric_list, std::vector<int> ngram_lengths, bool remove_punctuation, bool remove_numeric, int cores);
+RcppExport SEXP _SpeedReader_Extract_NGrams(SEXP token_listSEXP, SEXP punctuation_listSEXP, SEXP numeric_listSEXP, SEXP ngram_lengthsSEXP, SEXP remove_punctuationSEXP, SEXP remove_numericSEXP, SEXP coresSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type token_list(token_listSEXP);
+    Rcpp::traits::input_parameter< List >::type punctuation_list(punctuation_listSEXP);
+    Rcpp::traits::input_parameter< List >::type numeric_list(numeric_listSEXP);
+    Rcpp::traits::input_parameter< std::vector<int> >::type ngram_lengths(ngram_lengthsSEXP);
+    Rcpp::traits::input_parameter< bool >::type remove_punctuation(remove_punctuationSEXP);
+    Rcpp::traits::input_parameter< bool >::type remove_numeric(remove_numericSEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    rcpp_result_gen = Rcpp::wrap(Extract_NGrams(token_list, punctuation_list, numeric_list, ngram_lengths, remove_punctuation, remove_numeric, cores));
+    return rcpp_result_gen;
+END_RCPP
+}
 // Fast_Mutual_Information
 double Fast_Mutual_Information(arma::mat joint_dist, arma::vec non_zero_cols);
 RcppExport SEXP _SpeedReader_Fast_Mutual_Information(SEXP joint_distSEXP, SEXP non_zero_colsSEXP) {
@@ -257,6 +649,22 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// Ingest_Raw_Text
+List Ingest_Raw_Text(std::vector<std::string> files, std::vector<int> keep_characters, int non_ascii_mode, double term_frequency_threshold, int cores, int queue_size);
+RcppExport SEXP _SpeedReader_Ingest_Raw_Text(SEXP filesSEXP, SEXP keep_charactersSEXP, SEXP non_ascii_modeSEXP, SEXP term_frequency_thresholdSEXP, SEXP coresSEXP, SEXP queue_sizeSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::vector<std::string> >::type files(filesSEXP);
+    Rcpp::traits::input_parameter< std::vector<int> >::type keep_characters(keep_charactersSEXP);
+    Rcpp::traits::input_parameter< int >::type non_ascii_mode(non_ascii_modeSEXP);
+    Rcpp::traits::input_parameter< double >::type term_frequency_threshold(term_frequency_thresholdSEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    Rcpp::traits::input_parameter< int >::type queue_size(queue_sizeSEXP);
+    rcpp_result_gen = Rcpp::wrap(Ingest_Raw_Text(files, keep_characters, non_ascii_mode, term_frequency_threshold, cores, queue_size));
+    return rcpp_result_gen;
+END_RCPP
+}
 // LineWise_Dice_Coefficients
 arma::mat LineWise_Dice_Coefficients(int number_of_lines, List Lines, int number_of_lines2, List Lines2);
 RcppExport SEXP _SpeedReader_LineWise_Dice_Coefficients(SEXP number_of_linesSEXP, SEXP LinesSEXP, SEXP number_of_lines2SEXP, SEXP Lines2SEXP) {
@@ -271,6 +679,20 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// Multi_Dice_Coefficients
+List Multi_Dice_Coefficients(List documents_a, List documents_b, std::vector<int> ngram_sizes, int cores);
+RcppExport SEXP _SpeedReader_Multi_Dice_Coefficients(SEXP documents_aSEXP, SEXP documents_bSEXP, SEXP ngram_sizesSEXP, SEXP coresSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type documents_a(documents_aSEXP);
+    Rcpp::traits::input_parameter< List >::type documents_b(documents_bSEXP);
+    Rcpp::traits::input_parameter< std::vector<int> >::type ngram_sizes(ngram_sizesSEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    rcpp_result_gen = Rcpp::wrap(Multi_Dice_Coefficients(documents_a, documents_b, ngram_sizes, cores));
+    return rcpp_result_gen;
+END_RCPP
+}
 // Mutual_Information
 double Mutual_Information(arma::mat joint_dist);
 RcppExport SEXP _SpeedReader_Mutual_Information(SEXP joint_distSEXP) {
@@ -282,6 +704,83 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// Ngram_Sequence_Matches
+List Ngram_Sequence_Matches(std::vector<std::string> document_1, std::vector<std::string> document_2, std::vector<int> ngram_sizes, int minimum_block_length);
+RcppExport SEXP _SpeedReader_Ngram_Sequence_Matches(SEXP document_1SEXP, SEXP document_2SEXP, SEXP ngram_sizesSEXP, SEXP minimum_block_lengthSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::vector<std::string> >::type document_1(document_1SEXP);
+    Rcpp::traits::input_parameter< std::vector<std::string> >::type document_2(document_2SEXP);
+    Rcpp::traits::input_parameter< std::vector<int> >::type ngram_sizes(ngram_sizesSEXP);
+    Rcpp::traits::input_parameter< int >::type minimum_block_length(minimum_block_lengthSEXP);
+    rcpp_result_gen = Rcpp::wrap(Ngram_Sequence_Matches(document_1, document_2, ngram_sizes, minimum_block_length));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Count_Block_Terms
+List Count_Block_Terms(List document_term_vector_list, List document_term_count_list, int block);
+RcppExport SEXP _SpeedReader_Count_Block_Terms(SEXP document_term_vector_listSEXP, SEXP document_term_count_listSEXP, SEXP blockSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type document_term_vector_list(document_term_vector_listSEXP);
+    Rcpp::traits::input_parameter< List >::type document_term_count_list(document_term_count_listSEXP);
+    Rcpp::traits::input_parameter< int >::type block(blockSEXP);
+    rcpp_result_gen = Rcpp::wrap(Count_Block_Terms(document_term_vector_list, document_term_count_list, block));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Merge_Term_Count_Runs
+List Merge_Term_Count_Runs(List runs, int cores);
+RcppExport SEXP _SpeedReader_Merge_Term_Count_Runs(SEXP runsSEXP, SEXP coresSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type runs(runsSEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    rcpp_result_gen = Rcpp::wrap(Merge_Term_Count_Runs(runs, cores));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Read_CoNLL_Tokens
+List Read_CoNLL_Tokens(std::vector<std::string> files, int cores);
+RcppExport SEXP _SpeedReader_Read_CoNLL_Tokens(SEXP filesSEXP, SEXP coresSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::vector<std::string> >::type files(filesSEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    rcpp_result_gen = Rcpp::wrap(Read_CoNLL_Tokens(files, cores));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Read_Mallet_State
+List Read_Mallet_State(std::string state_file, int num_topics, int cores);
+RcppExport SEXP _SpeedReader_Read_Mallet_State(SEXP state_fileSEXP, SEXP num_topicsSEXP, SEXP coresSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::string >::type state_file(state_fileSEXP);
+    Rcpp::traits::input_parameter< int >::type num_topics(num_topicsSEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    rcpp_result_gen = Rcpp::wrap(Read_Mallet_State(state_file, num_topics, cores));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Read_Mallet_Doc_Topics
+arma::mat Read_Mallet_Doc_Topics(std::string doc_topics_file, int num_topics, int cores);
+RcppExport SEXP _SpeedReader_Read_Mallet_Doc_Topics(SEXP doc_topics_fileSEXP, SEXP num_topicsSEXP, SEXP coresSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::string >::type doc_topics_file(doc_topics_fileSEXP);
+    Rcpp::traits::input_parameter< int >::type num_topics(num_topicsSEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    rcpp_result_gen = Rcpp::wrap(Read_Mallet_Doc_Topics(doc_topics_file, num_topics, cores));
+    return rcpp_result_gen;
+END_RCPP
+}
 // reference_dist_distance
 arma::mat reference_dist_distance(arma::vec ref_dist_i, arma::vec ref_dist_j, arma::vec ref_dist_v, arma::vec target_dist_i, arma::vec target_dist_j, arma::vec target_dist_v, int num_ref_dists, int num_documents, arma::vec term_weights);
 RcppExport SEXP _SpeedReader_reference_dist_distance(SEXP ref_dist_iSEXP, SEXP ref_dist_jSEXP, SEXP ref_dist_vSEXP, SEXP target_dist_iSEXP, SEXP target_dist_jSEXP, SEXP target_dist_vSEXP, SEXP num_ref_distsSEXP, SEXP num_documentsSEXP, SEXP term_weightsSEXP) {
@@ -301,6 +800,35 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// Scheduled_Sequence_Comparison
+arma::mat Scheduled_Sequence_Comparison(std::vector<std::string> documents, arma::mat comparison_inds, int ngram_length, bool ngram_match_only, int cores);
+RcppExport SEXP _SpeedReader_Scheduled_Sequence_Comparison(SEXP documentsSEXP, SEXP comparison_indsSEXP, SEXP ngram_lengthSEXP, SEXP ngram_match_onlySEXP, SEXP coresSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::vector<std::string> >::type documents(documentsSEXP);
+    Rcpp::traits::input_parameter< arma::mat >::type comparison_inds(comparison_indsSEXP);
+    Rcpp::traits::input_parameter< int >::type ngram_length(ngram_lengthSEXP);
+    Rcpp::traits::input_parameter< bool >::type ngram_match_only(ngram_match_onlySEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    rcpp_result_gen = Rcpp::wrap(Scheduled_Sequence_Comparison(documents, comparison_inds, ngram_length, ngram_match_only, cores));
+    return rcpp_result_gen;
+END_RCPP
+}
+// NGram_Similarity_Join
+List NGram_Similarity_Join(std::vector<std::string> documents, int ngram_length, double threshold, int cores);
+RcppExport SEXP _SpeedReader_NGram_Similarity_Join(SEXP documentsSEXP, SEXP ngram_lengthSEXP, SEXP thresholdSEXP, SEXP coresSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::vector<std::string> >::type documents(documentsSEXP);
+    Rcpp::traits::input_parameter< int >::type ngram_length(ngram_lengthSEXP);
+    Rcpp::traits::input_parameter< double >::type threshold(thresholdSEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    rcpp_result_gen = Rcpp::wrap(NGram_Similarity_Join(documents, ngram_length, threshold, cores));
+    return rcpp_result_gen;
+END_RCPP
+}
 // Sparse_Document_Frequencies
 arma::vec Sparse_Document_Frequencies(int length_sparse_counts, arma::vec sparse_counts, arma::vec document_frequencies, arma::vec print_sequence, int print_sequence_length);
 RcppExport SEXP _SpeedReader_Sparse_Document_Frequencies(SEXP length_sparse_countsSEXP, SEXP sparse_countsSEXP, SEXP document_frequenciesSEXP, SEXP print_sequenceSEXP, SEXP print_sequence_lengthSEXP) {
@@ -335,6 +863,170 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// Subsume_NGrams
+List Subsume_NGrams(std::vector<std::string> terms, IntegerVector i, IntegerVector j, NumericVector v, int num_rows, int term_clusters_to_output, int top_terms_to_search, double correlation_threshold);
+RcppExport SEXP _SpeedReader_Subsume_NGrams(SEXP termsSEXP, SEXP iSEXP, SEXP jSEXP, SEXP vSEXP, SEXP num_rowsSEXP, SEXP term_clusters_to_outputSEXP, SEXP top_terms_to_searchSEXP, SEXP correlation_thresholdSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::vector<std::string> >::type terms(termsSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type i(iSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type j(jSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type v(vSEXP);
+    Rcpp::traits::input_parameter< int >::type num_rows(num_rowsSEXP);
+    Rcpp::traits::input_parameter< int >::type term_clusters_to_output(term_clusters_to_outputSEXP);
+    Rcpp::traits::input_parameter< int >::type top_terms_to_search(top_terms_to_searchSEXP);
+    Rcpp::traits::input_parameter< double >::type correlation_threshold(correlation_thresholdSEXP);
+    rcpp_result_gen = Rcpp::wrap(Subsume_NGrams(terms, i, j, v, num_rows, term_clusters_to_output, top_terms_to_search, correlation_threshold));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Telemetry_Report
+List Telemetry_Report();
+RcppExport SEXP _SpeedReader_Telemetry_Report() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(Telemetry_Report());
+    return rcpp_result_gen;
+END_RCPP
+}
+// Telemetry_Reset
+void Telemetry_Reset();
+RcppExport SEXP _SpeedReader_Telemetry_Reset() {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Telemetry_Reset();
+    return R_NilValue;
+END_RCPP
+}
+// Telemetry_Options
+void Telemetry_Options(bool verbose, double progress_interval);
+RcppExport SEXP _SpeedReader_Telemetry_Options(SEXP verboseSEXP, SEXP progress_intervalSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< bool >::type verbose(verboseSEXP);
+    Rcpp::traits::input_parameter< double >::type progress_interval(progress_intervalSEXP);
+    Telemetry_Options(verbose, progress_interval);
+    return R_NilValue;
+END_RCPP
+}
+// Block_Count_Frequent_Words
+List Block_Count_Frequent_Words(std::vector<std::string> files, double threshold, int sketch_width, int sketch_depth, int heavy_hitters, int cores);
+RcppExport SEXP _SpeedReader_Block_Count_Frequent_Words(SEXP filesSEXP, SEXP thresholdSEXP, SEXP sketch_widthSEXP, SEXP sketch_depthSEXP, SEXP heavy_hittersSEXP, SEXP coresSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::vector<std::string> >::type files(filesSEXP);
+    Rcpp::traits::input_parameter< double >::type threshold(thresholdSEXP);
+    Rcpp::traits::input_parameter< int >::type sketch_width(sketch_widthSEXP);
+    Rcpp::traits::input_parameter< int >::type sketch_depth(sketch_depthSEXP);
+    Rcpp::traits::input_parameter< int >::type heavy_hitters(heavy_hittersSEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    rcpp_result_gen = Rcpp::wrap(Block_Count_Frequent_Words(files, threshold, sketch_width, sketch_depth, heavy_hitters, cores));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Create_Term_Sketch
+SEXP Create_Term_Sketch(int sketch_width, int sketch_depth, int heavy_hitters);
+RcppExport SEXP _SpeedReader_Create_Term_Sketch(SEXP sketch_widthSEXP, SEXP sketch_depthSEXP, SEXP heavy_hittersSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< int >::type sketch_width(sketch_widthSEXP);
+    Rcpp::traits::input_parameter< int >::type sketch_depth(sketch_depthSEXP);
+    Rcpp::traits::input_parameter< int >::type heavy_hitters(heavy_hittersSEXP);
+    rcpp_result_gen = Rcpp::wrap(Create_Term_Sketch(sketch_width, sketch_depth, heavy_hitters));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Term_Sketch_Add
+void Term_Sketch_Add(SEXP sketch, List document_term_vector_list, List document_term_count_list);
+RcppExport SEXP _SpeedReader_Term_Sketch_Add(SEXP sketchSEXP, SEXP document_term_vector_listSEXP, SEXP document_term_count_listSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type sketch(sketchSEXP);
+    Rcpp::traits::input_parameter< List >::type document_term_vector_list(document_term_vector_listSEXP);
+    Rcpp::traits::input_parameter< List >::type document_term_count_list(document_term_count_listSEXP);
+    Term_Sketch_Add(sketch, document_term_vector_list, document_term_count_list);
+    return R_NilValue;
+END_RCPP
+}
+// Term_Sketch_Filter
+List Term_Sketch_Filter(SEXP sketch, List document_term_vector_list, List document_term_count_list, double threshold);
+RcppExport SEXP _SpeedReader_Term_Sketch_Filter(SEXP sketchSEXP, SEXP document_term_vector_listSEXP, SEXP document_term_count_listSEXP, SEXP thresholdSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type sketch(sketchSEXP);
+    Rcpp::traits::input_parameter< List >::type document_term_vector_list(document_term_vector_listSEXP);
+    Rcpp::traits::input_parameter< List >::type document_term_count_list(document_term_count_listSEXP);
+    Rcpp::traits::input_parameter< double >::type threshold(thresholdSEXP);
+    rcpp_result_gen = Rcpp::wrap(Term_Sketch_Filter(sketch, document_term_vector_list, document_term_count_list, threshold));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Term_Sketch_Heavy_Hitters
+List Term_Sketch_Heavy_Hitters(SEXP sketch);
+RcppExport SEXP _SpeedReader_Term_Sketch_Heavy_Hitters(SEXP sketchSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type sketch(sketchSEXP);
+    rcpp_result_gen = Rcpp::wrap(Term_Sketch_Heavy_Hitters(sketch));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Tokenize_Documents
+List Tokenize_Documents(std::vector<std::string> documents, std::vector<int> keep_characters, int non_ascii_mode, bool return_ids, int cores);
+RcppExport SEXP _SpeedReader_Tokenize_Documents(SEXP documentsSEXP, SEXP keep_charactersSEXP, SEXP non_ascii_modeSEXP, SEXP return_idsSEXP, SEXP coresSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::vector<std::string> >::type documents(documentsSEXP);
+    Rcpp::traits::input_parameter< std::vector<int> >::type keep_characters(keep_charactersSEXP);
+    Rcpp::traits::input_parameter< int >::type non_ascii_mode(non_ascii_modeSEXP);
+    Rcpp::traits::input_parameter< bool >::type return_ids(return_idsSEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    rcpp_result_gen = Rcpp::wrap(Tokenize_Documents(documents, keep_characters, non_ascii_mode, return_ids, cores));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Topic_Word_Distribution
+List Topic_Word_Distribution(std::vector<int> terms, std::vector<int> topics, std::vector<double> counts, int num_terms, int num_topics, double beta, int num_top_words, bool full_distribution, int cores);
+RcppExport SEXP _SpeedReader_Topic_Word_Distribution(SEXP termsSEXP, SEXP topicsSEXP, SEXP countsSEXP, SEXP num_termsSEXP, SEXP num_topicsSEXP, SEXP betaSEXP, SEXP num_top_wordsSEXP, SEXP full_distributionSEXP, SEXP coresSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::vector<int> >::type terms(termsSEXP);
+    Rcpp::traits::input_parameter< std::vector<int> >::type topics(topicsSEXP);
+    Rcpp::traits::input_parameter< std::vector<double> >::type counts(countsSEXP);
+    Rcpp::traits::input_parameter< int >::type num_terms(num_termsSEXP);
+    Rcpp::traits::input_parameter< int >::type num_topics(num_topicsSEXP);
+    Rcpp::traits::input_parameter< double >::type beta(betaSEXP);
+    Rcpp::traits::input_parameter< int >::type num_top_words(num_top_wordsSEXP);
+    Rcpp::traits::input_parameter< bool >::type full_distribution(full_distributionSEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    rcpp_result_gen = Rcpp::wrap(Topic_Word_Distribution(terms, topics, counts, num_terms, num_topics, beta, num_top_words, full_distribution, cores));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Sparse_Document_Text
+CharacterVector Sparse_Document_Text(std::vector<int> documents, std::vector<int> terms, std::vector<double> counts, std::vector<std::string> vocabulary, int num_documents, int cores);
+RcppExport SEXP _SpeedReader_Sparse_Document_Text(SEXP documentsSEXP, SEXP termsSEXP, SEXP countsSEXP, SEXP vocabularySEXP, SEXP num_documentsSEXP, SEXP coresSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::vector<int> >::type documents(documentsSEXP);
+    Rcpp::traits::input_parameter< std::vector<int> >::type terms(termsSEXP);
+    Rcpp::traits::input_parameter< std::vector<double> >::type counts(countsSEXP);
+    Rcpp::traits::input_parameter< std::vector<std::string> >::type vocabulary(vocabularySEXP);
+    Rcpp::traits::input_parameter< int >::type num_documents(num_documentsSEXP);
+    Rcpp::traits::input_parameter< int >::type cores(coresSEXP);
+    rcpp_result_gen = Rcpp::wrap(Sparse_Document_Text(documents, terms, counts, vocabulary, num_documents, cores));
+    return rcpp_result_gen;
+END_RCPP
+}
 // Sequential_Raw_Term_Dice_Matches
 List Sequential_Raw_Term_Dice_Matches(std::vector<std::string> line1, std::vector<std::string> line2, int Dice_Terms);
 RcppExport SEXP _SpeedReader_Sequential_Raw_Term_Dice_Matches(SEXP line1SEXP, SEXP line2SEXP, SEXP Dice_TermsSEXP) {
@@ -391,27 +1083,80 @@ END_RCPP
 }
 
 static const R_CallMethodDef CallEntries[] = {
+    {"_SpeedReader_Generate_Zipf_Corpus", (DL_FUNC) &_SpeedReader_Generate_Zipf_Corpus, 8},
+    {"_SpeedReader_Benchmark_Clock", (DL_FUNC) &_SpeedReader_Benchmark_Clock, 0},
+    {"_SpeedReader_Reset_Peak_Resident_Memory", (DL_FUNC) &_SpeedReader_Reset_Peak_Resident_Memory, 0},
+    {"_SpeedReader_Peak_Resident_Memory", (DL_FUNC) &_SpeedReader_Peak_Resident_Memory, 0},
     {"_SpeedReader_calculate_ACMI_contribution", (DL_FUNC) &_SpeedReader_calculate_ACMI_contribution, 9},
     {"_SpeedReader_calculate_unique_MI_contribution", (DL_FUNC) &_SpeedReader_calculate_unique_MI_contribution, 7},
-    {"_SpeedReader_calculate_document_frequency", (DL_FUNC) &_SpeedReader_calculate_document_frequency, 1},
-    {"_SpeedReader_Calculate_TFIDF", (DL_FUNC) &_SpeedReader_Calculate_TFIDF, 1},
+    {"_SpeedReader_calculate_document_frequency", (DL_FUNC) &_SpeedReader_calculate_document_frequency, 2},
+    {"_SpeedReader_Calculate_TFIDF", (DL_FUNC) &_SpeedReader_Calculate_TFIDF, 2},
     {"_SpeedReader_Col_and_Row_Sums", (DL_FUNC) &_SpeedReader_Col_and_Row_Sums, 1},
     {"_SpeedReader_Combine_Document_Term_Matrices", (DL_FUNC) &_SpeedReader_Combine_Document_Term_Matrices, 4},
+    {"_SpeedReader_Create_Corpus", (DL_FUNC) &_SpeedReader_Create_Corpus, 3},
+    {"_SpeedReader_Corpus_Info", (DL_FUNC) &_SpeedReader_Corpus_Info, 1},
+    {"_SpeedReader_Corpus_Vocabulary", (DL_FUNC) &_SpeedReader_Corpus_Vocabulary, 1},
+    {"_SpeedReader_Corpus_Documents", (DL_FUNC) &_SpeedReader_Corpus_Documents, 2},
+    {"_SpeedReader_Corpus_Count_Words", (DL_FUNC) &_SpeedReader_Corpus_Count_Words, 2},
+    {"_SpeedReader_Corpus_Document_Term_Matrix", (DL_FUNC) &_SpeedReader_Corpus_Document_Term_Matrix, 3},
+    {"_SpeedReader_Corpus_Sequence_Comparison", (DL_FUNC) &_SpeedReader_Corpus_Sequence_Comparison, 4},
+    {"_SpeedReader_Corpus_Dice_Coefficients", (DL_FUNC) &_SpeedReader_Corpus_Dice_Coefficients, 5},
     {"_SpeedReader_Count_Words", (DL_FUNC) &_SpeedReader_Count_Words, 11},
+    {"_SpeedReader_Create_CSR_Store", (DL_FUNC) &_SpeedReader_Create_CSR_Store, 3},
+    {"_SpeedReader_Append_CSR_Store", (DL_FUNC) &_SpeedReader_Append_CSR_Store, 5},
+    {"_SpeedReader_CSR_Store_Info", (DL_FUNC) &_SpeedReader_CSR_Store_Info, 1},
+    {"_SpeedReader_Verify_CSR_Store", (DL_FUNC) &_SpeedReader_Verify_CSR_Store, 1},
+    {"_SpeedReader_Extend_CSR_Store_Vocabulary", (DL_FUNC) &_SpeedReader_Extend_CSR_Store_Vocabulary, 2},
+    {"_SpeedReader_Rebuild_CSR_Store_Statistics", (DL_FUNC) &_SpeedReader_Rebuild_CSR_Store_Statistics, 2},
+    {"_SpeedReader_Slice_CSR_Store", (DL_FUNC) &_SpeedReader_Slice_CSR_Store, 3},
+    {"_SpeedReader_CSR_Store_Summary", (DL_FUNC) &_SpeedReader_CSR_Store_Summary, 2},
+    {"_SpeedReader_CSR_Store_Group_Column_Sums", (DL_FUNC) &_SpeedReader_CSR_Store_Group_Column_Sums, 4},
+    {"_SpeedReader_Distinct_Words", (DL_FUNC) &_SpeedReader_Distinct_Words, 3},
+    {"_SpeedReader_Frequency_Threshold", (DL_FUNC) &_SpeedReader_Frequency_Threshold, 2},
+    {"_SpeedReader_Write_Document_Term_Block", (DL_FUNC) &_SpeedReader_Write_Document_Term_Block, 3},
+    {"_SpeedReader_Read_Document_Term_Block", (DL_FUNC) &_SpeedReader_Read_Document_Term_Block, 1},
+    {"_SpeedReader_Block_Count_Words", (DL_FUNC) &_SpeedReader_Block_Count_Words, 2},
+    {"_SpeedReader_Block_Document_Term_Matrix", (DL_FUNC) &_SpeedReader_Block_Document_Term_Matrix, 3},
+    {"_SpeedReader_Text_Duplicate_Clusters", (DL_FUNC) &_SpeedReader_Text_Duplicate_Clusters, 4},
+    {"_SpeedReader_Token_Duplicate_Clusters", (DL_FUNC) &_SpeedReader_Token_Duplicate_Clusters, 4},
+    {"_SpeedReader_Corpus_Duplicate_Clusters", (DL_FUNC) &_SpeedReader_Corpus_Duplicate_Clusters, 4},
     {"_SpeedReader_Efficient_Block_Sequential_String_Set_Hash_Comparison", (DL_FUNC) &_SpeedReader_Efficient_Block_Sequential_String_Set_Hash_Comparison, 6},
     {"_SpeedReader_Efficient_Block_Hash_Ngrams", (DL_FUNC) &_SpeedReader_Efficient_Block_Hash_Ngrams, 6},
     {"_SpeedReader_String_Input_Sequential_String_Set_Hash_Comparison", (DL_FUNC) &_SpeedReader_String_Input_Sequential_String_Set_Hash_Comparison, 6},
+    {"_SpeedReader_Extract_NGrams", (DL_FUNC) &_SpeedReader_Extract_NGrams, 7},
     {"_SpeedReader_Fast_Mutual_Information", (DL_FUNC) &_SpeedReader_Fast_Mutual_Information, 2},
     {"_SpeedReader_Fast_Sparse_Mutual_Information", (DL_FUNC) &_SpeedReader_Fast_Sparse_Mutual_Information, 6},
     {"_SpeedReader_Fast_Sparse_Mutual_Information_Full", (DL_FUNC) &_SpeedReader_Fast_Sparse_Mutual_Information_Full, 6},
     {"_SpeedReader_Generate_Document_Term_Matrix", (DL_FUNC) &_SpeedReader_Generate_Document_Term_Matrix, 7},
     {"_SpeedReader_Generate_Sparse_Document_Term_Matrix_Stem_Vocabulary", (DL_FUNC) &_SpeedReader_Generate_Sparse_Document_Term_Matrix_Stem_Vocabulary, 11},
     {"_SpeedReader_Generate_Sparse_Document_Term_Matrix", (DL_FUNC) &_SpeedReader_Generate_Sparse_Document_Term_Matrix, 7},
+    {"_SpeedReader_Ingest_Raw_Text", (DL_FUNC) &_SpeedReader_Ingest_Raw_Text, 6},
     {"_SpeedReader_LineWise_Dice_Coefficients", (DL_FUNC) &_SpeedReader_LineWise_Dice_Coefficients, 4},
+    {"_SpeedReader_Multi_Dice_Coefficients", (DL_FUNC) &_SpeedReader_Multi_Dice_Coefficients, 4},
     {"_SpeedReader_Mutual_Information", (DL_FUNC) &_SpeedReader_Mutual_Information, 1},
+    {"_SpeedReader_Ngram_Sequence_Matches", (DL_FUNC) &_SpeedReader_Ngram_Sequence_Matches, 4},
+    {"_SpeedReader_Count_Block_Terms", (DL_FUNC) &_SpeedReader_Count_Block_Terms, 3},
+    {"_SpeedReader_Merge_Term_Count_Runs", (DL_FUNC) &_SpeedReader_Merge_Term_Count_Runs, 2},
+    {"_SpeedReader_Read_CoNLL_Tokens", (DL_FUNC) &_SpeedReader_Read_CoNLL_Tokens, 2},
+    {"_SpeedReader_Read_Mallet_State", (DL_FUNC) &_SpeedReader_Read_Mallet_State, 3},
+    {"_SpeedReader_Read_Mallet_Doc_Topics", (DL_FUNC) &_SpeedReader_Read_Mallet_Doc_Topics, 3},
     {"_SpeedReader_reference_dist_distance", (DL_FUNC) &_SpeedReader_reference_dist_distance, 9},
+    {"_SpeedReader_Scheduled_Sequence_Comparison", (DL_FUNC) &_SpeedReader_Scheduled_Sequence_Comparison, 5},
+    {"_SpeedReader_NGram_Similarity_Join", (DL_FUNC) &_SpeedReader_NGram_Similarity_Join, 4},
     {"_SpeedReader_Sparse_Document_Frequencies", (DL_FUNC) &_SpeedReader_Sparse_Document_Frequencies, 5},
     {"_SpeedReader_Sparse_PMI_Statistics", (DL_FUNC) &_SpeedReader_Sparse_PMI_Statistics, 9},
+    {"_SpeedReader_Subsume_NGrams", (DL_FUNC) &_SpeedReader_Subsume_NGrams, 8},
+    {"_SpeedReader_Telemetry_Report", (DL_FUNC) &_SpeedReader_Telemetry_Report, 0},
+    {"_SpeedReader_Telemetry_Reset", (DL_FUNC) &_SpeedReader_Telemetry_Reset, 0},
+    {"_SpeedReader_Telemetry_Options", (DL_FUNC) &_SpeedReader_Telemetry_Options, 2},
+    {"_SpeedReader_Block_Count_Frequent_Words", (DL_FUNC) &_SpeedReader_Block_Count_Frequent_Words, 6},
+    {"_SpeedReader_Create_Term_Sketch", (DL_FUNC) &_SpeedReader_Create_Term_Sketch, 3},
+    {"_SpeedReader_Term_Sketch_Add", (DL_FUNC) &_SpeedReader_Term_Sketch_Add, 3},
+    {"_SpeedReader_Term_Sketch_Filter", (DL_FUNC) &_SpeedReader_Term_Sketch_Filter, 4},
+    {"_SpeedReader_Term_Sketch_Heavy_Hitters", (DL_FUNC) &_SpeedReader_Term_Sketch_Heavy_Hitters, 1},
+    {"_SpeedReader_Tokenize_Documents", (DL_FUNC) &_SpeedReader_Tokenize_Documents, 5},
+    {"_SpeedReader_Topic_Word_Distribution", (DL_FUNC) &_SpeedReader_Topic_Word_Distribution, 9},
+    {"_SpeedReader_Sparse_Document_Text", (DL_FUNC) &_SpeedReader_Sparse_Document_Text, 6},
     {"_SpeedReader_Sequential_Raw_Term_Dice_Matches", (DL_FUNC) &_SpeedReader_Sequential_Raw_Term_Dice_Matches, 3},
     {"_SpeedReader_Sequential_string_Set_Hash_Comparison", (DL_FUNC) &_SpeedReader_Sequential_string_Set_Hash_Comparison, 3},
     {"_SpeedReader_Sequential_Token_Set_Hash_Comparison", (DL_FUNC) &_SpeedReader_Sequential_Token_Set_Hash_Comparison, 2},
@@ -0,0 +1,100 @@
+// [[Rcpp::plugins(cpp11)]]
+#include <RcppArmadillo.h>
+#include <string>
+#include "Block_File.h"
+#include "CoNLL_Reader.h"
+#include "Parallel.h"
+//[[Rcpp::depends(RcppArmadillo)]]
+using namespace Rcpp;
+
+namespace mjd {
+    CharacterVector utf8_character_vector(const std::vector<std::string>& v);
+    void stop_on_error(const std::vector<std::string>& errors);
+}
+
+// Reads CoreNLP CoNLL output files (one per document) in parallel into one
+// columnar token table. Each thread memory maps its files and interns their
+// strings into a local vocabulary, and the vocabularies are then merged in
+// file order. Returns the shared string table, one based word, lemma, POS
+// and NER ids (NA where a line has too few fields), punctuation and numeric
+// indicators for each token's word, sentence numbers, and the zero based
+// offset of each document's first token (plus the total number of tokens).
+// [[Rcpp::export]]
+List Read_CoNLL_Tokens(std::vector<std::string> files,
+                       int cores){
+
+    int num_files = files.size();
+    int ranges = mjd::parallel_ranges(num_files, cores);
+    std::vector<mjd::Vocabulary> local_vocabularies(ranges);
+    std::vector<mjd::TokenColumns> tables(ranges);
+    std::vector<std::string> errors(ranges);
+    mjd::parallel_for(num_files, cores, [&](int start, int end, int t) {
+        for (int i = start; i < end; ++i) {
+            mjd::MappedFile file;
+            if (!file.open(files[i], errors[t])) {
+                return;
+            }
+            mjd::parse_conll_document(file.data(), file.size(),
+                                      local_vocabularies[t], tables[t]);
+        }
+    });
+    mjd::stop_on_error(errors);
+
+    mjd::Vocabulary vocabulary;
+    std::vector<std::vector<int> > remaps = vocabulary.merge(local_vocabularies);
+    std::vector<char> punctuation(vocabulary.size());
+    std::vector<char> numeric(vocabulary.size());
+    mjd::parallel_for(vocabulary.size(), cores, [&](int start, int end, int t) {
+        for (int id = start; id < end; ++id) {
+            punctuation[id] = mjd::has_punctuation(vocabulary.term(id));
+            numeric[id] = mjd::has_digit(vocabulary.term(id));
+        }
+    });
+
+    size_t num_tokens = 0;
+    std::vector<size_t> first_token(ranges + 1, 0);
+    for (int t = 0; t < ranges; ++t) {
+        num_tokens += tables[t].size();
+        first_token[t + 1] = num_tokens;
+    }
+    IntegerVector columns[mjd::CONLL_COLUMNS];
+    for (int c = 0; c < mjd::CONLL_COLUMNS; ++c) {
+        columns[c] = IntegerVector(num_tokens);
+    }
+    IntegerVector punctuation_flags(num_tokens);
+    IntegerVector numeric_flags(num_tokens);
+    IntegerVector sentences(num_tokens);
+    NumericVector offsets(num_files + 1);
+    int document = 0;
+    for (int t = 0; t < ranges; ++t) {
+        const mjd::TokenColumns& table = tables[t];
+        const std::vector<int>& remap = remaps[t];
+        size_t base = first_token[t];
+        for (size_t k = 0; k < table.size(); ++k) {
+            for (int c = 0; c < mjd::CONLL_COLUMNS; ++c) {
+                int local = table.columns[c][k];
+                columns[c][base + k] = local < 0 ? NA_INTEGER : remap[local] + 1;
+            }
+            int word = table.columns[mjd::CONLL_WORD][k];
+            punctuation_flags[base + k] = word >= 0 && punctuation[remap[word]];
+            numeric_flags[base + k] = word >= 0 && numeric[remap[word]];
+            sentences[base + k] = table.sentence[k];
+        }
+        for (size_t d = 0; d + 1 < table.offsets.size(); ++d) {
+            offsets[document++] = base + table.offsets[d];
+        }
+    }
+    offsets[num_files] = num_tokens;
+
+    List to_return(9);
+    to_return[0] = mjd::utf8_character_vector(vocabulary.all_terms());
+    to_return[1] = columns[mjd::CONLL_WORD];
+    to_return[2] = columns[mjd::CONLL_LEMMA];
+    to_return[3] = columns[mjd::CONLL_POS];
+    to_return[4] = columns[mjd::CONLL_NER];
+    to_return[5] = punctuation_flags;
+    to_return[6] = numeric_flags;
+    to_return[7] = sentences;
+    to_return[8] = offsets;
+    return to_return;
+}
@@ -0,0 +1,272 @@
+// [[Rcpp::plugins(cpp11)]]
+#include <RcppArmadillo.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include "Parallel.h"
+#include "Mallet_Reader.h"
+#include "Topic_Words.h"
+//[[Rcpp::depends(RcppArmadillo)]]
+using namespace Rcpp;
+
+namespace mjd {
+    CharacterVector utf8_character_vector(const std::vector<std::string>& v);
+
+    // lines handed to the worker threads at a time, which bounds the memory
+    // used for raw text regardless of the size of the file.
+    const size_t MALLET_CHUNK_LINES = 1 << 16;
+
+    // one based line number of the first line in a chunk that failed to
+    // parse, or 0 if all of them did.
+    size_t first_failed_line(const std::vector<char>& parsed,
+                             size_t lines_before) {
+        for (size_t k = 0; k < parsed.size(); ++k) {
+            if (!parsed[k]) {
+                return lines_before + k + 1;
+            }
+        }
+        return 0;
+    }
+}
+
+// Streams a MALLET Gibbs sampling state file (gzip compressed or not) and
+// aggregates it into sparse document-topic and term-topic counts, without
+// decompressing it to disk or holding more than a chunk of lines in memory.
+// Lines in each chunk are parsed in parallel and then counted in file order.
+// Returns alpha, beta, one based document-topic triplets (i, j, v), the
+// number of documents, one based term-topic triplets, and the terms (rows of
+// the term-topic counts, in MALLET type index order).
+// [[Rcpp::export]]
+List Read_Mallet_State(std::string state_file,
+                       int num_topics,
+                       int cores){
+
+    std::string error;
+    mjd::GzipLineReader reader;
+    if (!reader.open(state_file, error)) {
+        Rcpp::stop(error);
+    }
+
+    std::vector<double> alpha;
+    std::vector<double> beta;
+
+    // documents come in order, so document-topic counts are kept densely
+    // for the current document only and flushed when it changes.
+    std::vector<int> doc_i;
+    std::vector<int> doc_j;
+    std::vector<double> doc_v;
+    std::vector<int> current_counts(num_topics, 0);
+    std::vector<int> current_topics;
+    long current_document = -1;
+
+    // term-topic counts are taken by the threads parsing each chunk.
+    mjd::TopicWordCounts term_topic_counts(
+        num_topics, mjd::resolve_cores(cores, mjd::MALLET_CHUNK_LINES));
+    std::vector<std::string> types;
+    std::vector<char> type_seen;
+
+    mjd::LineChunk chunk;
+    std::vector<mjd::StateToken> tokens;
+    std::vector<char> parsed;
+    size_t lines_before = 0;
+    while (reader.read_chunk(chunk, mjd::MALLET_CHUNK_LINES, error)) {
+        int n = chunk.size();
+        tokens.resize(n);
+        parsed.assign(n, 1);
+        mjd::parallel_for(n, cores, [&](int start, int end, int t) {
+            std::vector<const char*> fields;
+            std::vector<size_t> lengths;
+            for (int k = start; k < end; ++k) {
+                const char* line = chunk.line(k);
+                if (mjd::is_data_line(line)) {
+                    parsed[k] = mjd::parse_state_line(line, tokens[k],
+                                                      fields, lengths) &&
+                        tokens[k].topic < num_topics;
+                    if (parsed[k]) {
+                        term_topic_counts.add(t, tokens[k].type_index,
+                                              tokens[k].topic);
+                    }
+                }
+            }
+        });
+        size_t failed = mjd::first_failed_line(parsed, lines_before);
+        if (failed > 0) {
+            Rcpp::stop("Could not parse line " + std::to_string(failed) +
+                " of " + state_file + " as a token with one of " +
+                std::to_string(num_topics) + " topics.");
+        }
+
+        for (int k = 0; k < n; ++k) {
+            const char* line = chunk.line(k);
+            if (!mjd::is_data_line(line)) {
+                if (std::strncmp(line, "#alpha", 6) == 0) {
+                    alpha = mjd::parse_header_values(line);
+                } else if (std::strncmp(line, "#beta", 5) == 0) {
+                    beta = mjd::parse_header_values(line);
+                }
+                continue;
+            }
+            const mjd::StateToken& token = tokens[k];
+            if (token.document != current_document) {
+                if (token.document < current_document) {
+                    Rcpp::stop("The tokens in " + state_file +
+                        " are not ordered by document.");
+                }
+                std::sort(current_topics.begin(), current_topics.end());
+                for (size_t m = 0; m < current_topics.size(); ++m) {
+                    doc_i.push_back(current_document + 1);
+                    doc_j.push_back(current_topics[m] + 1);
+                    doc_v.push_back(current_counts[current_topics[m]]);
+                    current_counts[current_topics[m]] = 0;
+                }
+                current_topics.clear();
+                current_document = token.document;
+            }
+            if (current_counts[token.topic] == 0) {
+                current_topics.push_back(token.topic);
+            }
+            current_counts[token.topic] += 1;
+
+            size_t type_index = token.type_index;
+            if (type_index >= types.size()) {
+                types.resize(type_index + 1);
+                type_seen.resize(type_index + 1, 0);
+            }
+            if (!type_seen[type_index]) {
+                type_seen[type_index] = 1;
+                types[type_index].assign(token.type, token.type_length);
+            }
+        }
+        lines_before += n;
+    }
+    if (!error.empty()) {
+        Rcpp::stop(error);
+    }
+    std::sort(current_topics.begin(), current_topics.end());
+    for (size_t m = 0; m < current_topics.size(); ++m) {
+        doc_i.push_back(current_document + 1);
+        doc_j.push_back(current_topics[m] + 1);
+        doc_v.push_back(current_counts[current_topics[m]]);
+    }
+
+    // terms that occur in the state become rows, in type index order.
+    std::vector<int> row_of_type(types.size(), 0);
+    std::vector<std::string> terms;
+    for (size_t type = 0; type < types.size(); ++type) {
+        if (type_seen[type]) {
+            terms.push_back(types[type]);
+            row_of_type[type] = terms.size();
+        }
+    }
+    std::vector<uint64_t> count_types;
+    std::vector<int> count_topics;
+    std::vector<double> count_values;
+    term_topic_counts.merge(count_types, count_topics, count_values);
+    IntegerVector term_i(count_types.size());
+    IntegerVector term_j(count_types.size());
+    for (size_t k = 0; k < count_types.size(); ++k) {
+        term_i[k] = row_of_type[count_types[k]];
+        term_j[k] = count_topics[k] + 1;
+    }
+
+    List document_topics(3);
+    document_topics[0] = IntegerVector(doc_i.begin(), doc_i.end());
+    document_topics[1] = IntegerVector(doc_j.begin(), doc_j.end());
+    document_topics[2] = NumericVector(doc_v.begin(), doc_v.end());
+    List term_topics(3);
+    term_topics[0] = term_i;
+    term_topics[1] = term_j;
+    term_topics[2] = NumericVector(count_values.begin(), count_values.end());
+
+    List to_return(6);
+    to_return[0] = NumericVector(alpha.begin(), alpha.end());
+    to_return[1] = NumericVector(beta.begin(), beta.end());
+    to_return[2] = document_topics;
+    to_return[3] = double(current_document + 1);
+    to_return[4] = term_topics;
+    to_return[5] = mjd::utf8_character_vector(terms);
+    return to_return;
+}
+
+// Reads MALLET's doc-topics output into a documents x topics matrix of
+// proportions, one row per line in file order. The file is read twice, once
+// to count its rows (and find its layout from the first line) and once to
+// fill them, a chunk of lines at a time with the lines of each chunk split
+// and parsed in parallel.
+// [[Rcpp::export]]
+arma::mat Read_Mallet_Doc_Topics(std::string doc_topics_file,
+                                 int num_topics,
+                                 int cores){
+
+    std::string error;
+    mjd::LineChunk chunk;
+    size_t num_rows = 0;
+    mjd::DocTopicsLayout layout = mjd::DOC_TOPICS_DENSE;
+    {
+        mjd::GzipLineReader reader;
+        if (!reader.open(doc_topics_file, error)) {
+            Rcpp::stop(error);
+        }
+        bool first_chunk = true;
+        while (reader.read_chunk(chunk, mjd::MALLET_CHUNK_LINES, error)) {
+            if (first_chunk && chunk.size() > 0) {
+                layout = mjd::doc_topics_layout(chunk.line(0));
+                first_chunk = false;
+            }
+            for (size_t k = 0; k < chunk.size(); ++k) {
+                num_rows += mjd::is_data_line(chunk.line(k));
+            }
+        }
+        if (!error.empty()) {
+            Rcpp::stop(error);
+        }
+    }
+
+    arma::mat doc_topics = arma::zeros(num_rows, num_topics);
+    mjd::GzipLineReader reader;
+    if (!reader.open(doc_topics_file, error)) {
+        Rcpp::stop(error);
+    }
+    std::vector<size_t> rows;
+    std::vector<char> parsed;
+    size_t next_row = 0;
+    size_t lines_before = 0;
+    while (reader.read_chunk(chunk, mjd::MALLET_CHUNK_LINES, error)) {
+        int n = chunk.size();
+        rows.resize(n);
+        for (int k = 0; k < n; ++k) {
+            rows[k] = next_row;
+            next_row += mjd::is_data_line(chunk.line(k));
+        }
+        if (next_row > num_rows) {
+            Rcpp::stop("The file " + doc_topics_file +
+                " changed while it was being read.");
+        }
+        parsed.assign(n, 1);
+        double* values = doc_topics.memptr();
+        mjd::parallel_for(n, cores, [&](int start, int end, int t) {
+            std::vector<const char*> fields;
+            std::vector<size_t> lengths;
+            for (int k = start; k < end; ++k) {
+                const char* line = chunk.line(k);
+                if (mjd::is_data_line(line)) {
+                    parsed[k] = mjd::parse_doc_topics_line(
+                        line, layout, num_topics, values + rows[k], num_rows,
+                        fields, lengths);
+                }
+            }
+        });
+        size_t failed = mjd::first_failed_line(parsed, lines_before);
+        if (failed > 0) {
+            Rcpp::stop("Could not parse line " + std::to_string(failed) +
+                " of " + doc_topics_file + " as topic proportions for " +
+                std::to_string(num_topics) + " topics.");
+        }
+        lines_before += n;
+    }
+    if (!error.empty()) {
+        Rcpp::stop(error);
+    }
+    return doc_topics;
+}
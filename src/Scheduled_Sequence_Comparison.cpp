@@ -0,0 +1,116 @@
+// [[Rcpp::plugins(cpp11)]]
+#include <RcppArmadillo.h>
+#include <string>
+#include <unordered_set>
+#include "String_NGrams.h"
+#include "Telemetry.h"
+#include "Work_Stealing.h"
+//[[Rcpp::depends(RcppArmadillo)]]
+using namespace Rcpp;
+
+namespace mjd {
+    arma::vec calculate_metrics(arma::vec which_a_in_b,
+                                arma::vec which_b_in_a,
+                                int ngram_size);
+
+    // Which of the n-grams in a appear anywhere in b (as a 0/1 mask).
+    inline void string_ngram_matches(const std::vector<std::string>& a,
+                                     const std::unordered_set<std::string>& b,
+                                     arma::vec& mask) {
+        mask = arma::zeros(a.size());
+        for (size_t k = 0; k < a.size(); ++k) {
+            if (b.count(a[k]) > 0) {
+                mask[k] = 1;
+            }
+        }
+    }
+}
+
+// Compares the pairs of documents in the (zero based) rows of comparison_inds
+// as String_Input_Sequential_String_Set_Hash_Comparison() does, returning
+// the same 37 statistics for each (or only the proportions of n-grams of
+// each document found in the other if ngram_match_only is TRUE). Every
+// document in a pair is split and hashed once, into tables shared by all
+// threads, and the comparisons are then run on cores threads as tasks of
+// similar cost (the number of n-grams they look up), with idle threads
+// stealing work from busy ones.
+// [[Rcpp::export]]
+arma::mat Scheduled_Sequence_Comparison(std::vector<std::string> documents,
+                                        arma::mat comparison_inds,
+                                        int ngram_length,
+                                        bool ngram_match_only,
+                                        int cores){
+    int num_docs = documents.size();
+    int num_comparisons = comparison_inds.n_rows;
+    std::vector<int> first(num_comparisons);
+    std::vector<int> second(num_comparisons);
+    std::vector<char> used(num_docs, 0);
+    for (int c = 0; c < num_comparisons; ++c) {
+        first[c] = comparison_inds(c, 0);
+        second[c] = comparison_inds(c, 1);
+        if (first[c] < 0 || first[c] >= num_docs ||
+            second[c] < 0 || second[c] >= num_docs) {
+            Rcpp::stop("Comparison index out of range of the documents.");
+        }
+        used[first[c]] = 1;
+        used[second[c]] = 1;
+    }
+
+    mjd::PhaseTimer hashing("Scheduled_Sequence_Comparison.hashing");
+    std::vector<double> hash_costs(num_docs, 0);
+    int hashed = 0;
+    for (int d = 0; d < num_docs; ++d) {
+        if (used[d]) {
+            hash_costs[d] = documents[d].size() + 1;
+            ++hashed;
+        }
+    }
+    std::vector<std::vector<std::string> > ngrams(num_docs);
+    std::vector<std::unordered_set<std::string> > dictionaries(num_docs);
+    long steals = mjd::work_stealing_for(hash_costs, cores,
+                                         [&](int start, int end, int t) {
+        for (int d = start; d < end; ++d) {
+            if (used[d]) {
+                mjd::string_sequence_ngrams(documents[d], ngram_length,
+                                            ngrams[d]);
+                dictionaries[d].insert(ngrams[d].begin(), ngrams[d].end());
+            }
+        }
+    });
+    hashing.stop();
+
+    // calculate_metrics() only uses Armadillo, which never calls back into R
+    // for the non-empty masks every document here produces, so the
+    // statistics are computed on the worker threads too.
+    mjd::PhaseTimer comparing("Scheduled_Sequence_Comparison.comparing");
+    std::vector<double> costs(num_comparisons);
+    for (int c = 0; c < num_comparisons; ++c) {
+        costs[c] = ngrams[first[c]].size() + ngrams[second[c]].size();
+    }
+    arma::mat comparison_metrics = arma::zeros(num_comparisons,
+                                               ngram_match_only ? 2 : 37);
+    steals += mjd::work_stealing_for(costs, cores,
+                                     [&](int start, int end, int t) {
+        arma::vec which_a_in_b;
+        arma::vec which_b_in_a;
+        for (int c = start; c < end; ++c) {
+            mjd::string_ngram_matches(ngrams[first[c]], dictionaries[second[c]],
+                                      which_a_in_b);
+            mjd::string_ngram_matches(ngrams[second[c]], dictionaries[first[c]],
+                                      which_b_in_a);
+            if (ngram_match_only) {
+                comparison_metrics(c, 0) = arma::mean(which_a_in_b);
+                comparison_metrics(c, 1) = arma::mean(which_b_in_a);
+            } else {
+                comparison_metrics.row(c) = arma::trans(mjd::calculate_metrics(
+                    which_a_in_b, which_b_in_a, ngram_length));
+            }
+        }
+    });
+    comparing.stop();
+
+    mjd::telemetry().counter("Scheduled_Sequence_Comparison.documents") += hashed;
+    mjd::telemetry().counter("Scheduled_Sequence_Comparison.comparisons") += num_comparisons;
+    mjd::telemetry().counter("Scheduled_Sequence_Comparison.steals") += steals;
+    return comparison_metrics;
+}
@@ -0,0 +1,112 @@
+// [[Rcpp::plugins(cpp11)]]
+#include <RcppArmadillo.h>
+#include <string>
+#include <unordered_map>
+#include "Parallel.h"
+#include "Similarity_Join.h"
+#include "String_NGrams.h"
+#include "Telemetry.h"
+#include "Vocabulary.h"
+//[[Rcpp::depends(RcppArmadillo)]]
+using namespace Rcpp;
+
+// Finds every pair of documents in which at least threshold of the n-grams of
+// one (formed as String_Input_Sequential_String_Set_Hash_Comparison() forms
+// them, and counting repeats) appear in the other, without comparing every
+// pair. N-grams are interned on cores threads and numbered from the rarest
+// (in the fewest documents) to the most common, and SimilarityJoin then
+// probes each document's prefix of rare n-grams with length and positional
+// filtering. Returns the one based documents of each pair (doc_1 < doc_2) and
+// their prop_a_in_b and prop_b_in_a, as Efficient_Block_Hash_Ngrams()
+// computes them.
+// [[Rcpp::export]]
+List NGram_Similarity_Join(std::vector<std::string> documents,
+                           int ngram_length,
+                           double threshold,
+                           int cores){
+    if (threshold <= 0 || threshold > 1) {
+        Rcpp::stop("threshold must be greater than 0 and at most 1.");
+    }
+    int num_docs = documents.size();
+
+    mjd::PhaseTimer hashing("NGram_Similarity_Join.hashing");
+    int ranges = mjd::parallel_ranges(num_docs, cores);
+    std::vector<mjd::Vocabulary> locals(ranges);
+    std::vector<int> range_of(num_docs, 0);
+    std::vector<mjd::NGramSet> sets(num_docs);
+    mjd::parallel_for(num_docs, cores, [&](int start, int end, int t) {
+        std::vector<std::string> ngrams;
+        std::unordered_map<int, int> counts;
+        for (int d = start; d < end; ++d) {
+            range_of[d] = t;
+            mjd::string_sequence_ngrams(documents[d], ngram_length, ngrams);
+            counts.clear();
+            for (size_t k = 0; k < ngrams.size(); ++k) {
+                ++counts[locals[t].intern(ngrams[k])];
+            }
+            for (std::unordered_map<int, int>::const_iterator it = counts.begin();
+                 it != counts.end(); ++it) {
+                sets[d].ids.push_back(it->first);
+                sets[d].counts.push_back(it->second);
+            }
+            sets[d].total = ngrams.size();
+        }
+    });
+
+    // number n-grams from those in the fewest documents to those in the
+    // most, by ranking their negated document frequencies.
+    mjd::Vocabulary vocabulary;
+    std::vector<std::vector<int> > remaps = vocabulary.merge(locals);
+    std::vector<double> rarity(vocabulary.size(), 0);
+    for (int d = 0; d < num_docs; ++d) {
+        const std::vector<int>& remap = remaps[range_of[d]];
+        for (size_t k = 0; k < sets[d].ids.size(); ++k) {
+            sets[d].ids[k] = remap[sets[d].ids[k]];
+            rarity[sets[d].ids[k]] -= 1;
+        }
+    }
+    std::vector<int> order = mjd::frequency_ranking(rarity);
+    mjd::parallel_for(num_docs, cores, [&](int start, int end, int t) {
+        std::vector<std::pair<int, int> > ranked;
+        for (int d = start; d < end; ++d) {
+            mjd::NGramSet& set = sets[d];
+            ranked.resize(set.ids.size());
+            for (size_t k = 0; k < set.ids.size(); ++k) {
+                ranked[k] = std::make_pair(order[set.ids[k]], set.counts[k]);
+            }
+            std::sort(ranked.begin(), ranked.end());
+            for (size_t k = 0; k < ranked.size(); ++k) {
+                set.ids[k] = ranked[k].first;
+                set.counts[k] = ranked[k].second;
+            }
+        }
+    });
+    hashing.stop();
+
+    mjd::PhaseTimer joining("NGram_Similarity_Join.joining");
+    mjd::SimilarityJoin join(sets, vocabulary.size(), threshold);
+    std::vector<mjd::JoinedPair> pairs = join.pairs(cores);
+    joining.stop();
+
+    int num_pairs = pairs.size();
+    IntegerVector doc_1(num_pairs);
+    IntegerVector doc_2(num_pairs);
+    NumericVector prop_a_in_b(num_pairs);
+    NumericVector prop_b_in_a(num_pairs);
+    for (int k = 0; k < num_pairs; ++k) {
+        doc_1[k] = pairs[k].a + 1;
+        doc_2[k] = pairs[k].b + 1;
+        prop_a_in_b[k] = pairs[k].a_in_b;
+        prop_b_in_a[k] = pairs[k].b_in_a;
+    }
+    mjd::telemetry().counter("NGram_Similarity_Join.documents") += num_docs;
+    mjd::telemetry().counter("NGram_Similarity_Join.candidates") += join.verified();
+    mjd::telemetry().counter("NGram_Similarity_Join.pairs") += num_pairs;
+
+    List to_return(4);
+    to_return[0] = doc_1;
+    to_return[1] = doc_2;
+    to_return[2] = prop_a_in_b;
+    to_return[3] = prop_b_in_a;
+    return to_return;
+}
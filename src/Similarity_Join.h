@@ -0,0 +1,251 @@
+#ifndef SPEEDREADER_SIMILARITY_JOIN_H
+#define SPEEDREADER_SIMILARITY_JOIN_H
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include "Work_Stealing.h"
+
+namespace mjd {
+
+    // The distinct n-grams of a document, as ids in ascending order, with the
+    // number of times each occurs and the number of n-grams in the document
+    // (counting repeats). Ids must follow one global order shared by every
+    // document; the join works best if the rarest n-grams come first.
+    struct NGramSet {
+        std::vector<int> ids;
+        std::vector<int> counts;
+        int total;
+    };
+
+    // A pair of documents (a < b) and the proportions of the n-grams of each
+    // that appear in the other.
+    struct JoinedPair {
+        int a;
+        int b;
+        double a_in_b;
+        double b_in_a;
+    };
+
+    // The smallest number of a document's total n-grams that must be found
+    // in another for their proportion to reach threshold, computed with the
+    // same division the proportions themselves use so that no pair lands on
+    // the other side of the threshold through rounding.
+    inline int required_overlap(int total, double threshold) {
+        int need = std::ceil(threshold * total);
+        while (need > 0 && double(need - 1) / total >= threshold) {
+            --need;
+        }
+        while (need < total && double(need) / total < threshold) {
+            ++need;
+        }
+        return std::max(need, 1);
+    }
+
+    // How many of the n-grams of a appear in b (in_a) and of b appear in a
+    // (in_b), looking each distinct n-gram of the smaller set up in the
+    // larger.
+    inline void overlap_counts(const NGramSet& a,
+                               const NGramSet& b,
+                               int& in_a,
+                               int& in_b) {
+        bool a_smaller = a.ids.size() <= b.ids.size();
+        const NGramSet& small = a_smaller ? a : b;
+        const NGramSet& large = a_smaller ? b : a;
+        int in_small = 0;
+        int in_large = 0;
+        std::vector<int>::const_iterator from = large.ids.begin();
+        for (size_t k = 0; k < small.ids.size(); ++k) {
+            from = std::lower_bound(from, large.ids.end(), small.ids[k]);
+            if (from == large.ids.end()) {
+                break;
+            }
+            if (*from == small.ids[k]) {
+                in_small += small.counts[k];
+                in_large += large.counts[from - large.ids.begin()];
+            }
+        }
+        in_a = a_smaller ? in_small : in_large;
+        in_b = a_smaller ? in_large : in_small;
+    }
+
+    // An exact self join of n-gram sets, finding every pair of documents in
+    // which at least threshold of the n-grams of one (counting repeats)
+    // appear in the other. Each document a is probed against an inverted
+    // index of every document's n-grams, using:
+    //
+    // - prefix filtering: only the n-grams before the point where a's
+    //   remaining n-grams could no longer reach the threshold on their own
+    //   are looked up, and as ids put rare n-grams first these have short
+    //   posting lists;
+    // - length filtering: documents with fewer distinct n-grams than the
+    //   fewest of a's that could reach the threshold are skipped;
+    // - positional filtering: a candidate is dropped as soon as the n-grams
+    //   it has matched so far, plus those left after the matching position in
+    //   both documents, could not reach the threshold.
+    //
+    // Surviving candidates are verified exactly, so no qualifying pair is
+    // missed and no other pair is returned.
+    class SimilarityJoin {
+    public:
+        SimilarityJoin(const std::vector<NGramSet>& sets,
+                       int vocabulary_size,
+                       double threshold)
+            : sets(sets), threshold(threshold), postings(vocabulary_size),
+              candidates(0) {
+            for (size_t d = 0; d < sets.size(); ++d) {
+                for (size_t j = 0; j < sets[d].ids.size(); ++j) {
+                    Posting posting = {int(d), int(j)};
+                    postings[sets[d].ids[j]].push_back(posting);
+                }
+            }
+        }
+
+        // every qualifying pair, probed on cores threads, in order of a and
+        // then b.
+        std::vector<JoinedPair> pairs(int cores) {
+            int num_docs = sets.size();
+            std::vector<double> costs(num_docs);
+            for (int d = 0; d < num_docs; ++d) {
+                costs[d] = 1;
+                int prefix = prefix_length(d);
+                for (int i = 0; i < prefix; ++i) {
+                    costs[d] += postings[sets[d].ids[i]].size();
+                }
+            }
+            int threads = resolve_cores(cores, num_docs);
+            std::vector<std::vector<JoinedPair> > found(threads);
+            std::vector<long> probed(threads, 0);
+            std::vector<std::vector<int> > matched(threads);
+            std::vector<std::vector<int> > touched(threads);
+            work_stealing_for(costs, threads, [&](int start, int end, int t) {
+                matched[t].resize(num_docs, 0);
+                for (int d = start; d < end; ++d) {
+                    probed[t] += probe(d, matched[t], touched[t], found[t]);
+                }
+            });
+
+            std::vector<JoinedPair> joined;
+            for (int t = 0; t < threads; ++t) {
+                joined.insert(joined.end(), found[t].begin(), found[t].end());
+                candidates += probed[t];
+            }
+            std::sort(joined.begin(), joined.end(),
+                      [](const JoinedPair& x, const JoinedPair& y) {
+                          return x.a < y.a || (x.a == y.a && x.b < y.b);
+                      });
+            return joined;
+        }
+
+        // the number of candidate pairs verified by the last call to pairs().
+        long verified() const {
+            return candidates;
+        }
+
+    private:
+        struct Posting {
+            int document;
+            int position;
+        };
+
+        const std::vector<NGramSet>& sets;
+        double threshold;
+        std::vector<std::vector<Posting> > postings;
+        long candidates;
+
+        // the number of leading n-grams of document d that any set of its
+        // n-grams reaching the threshold must include one of.
+        int prefix_length(int d) const {
+            const NGramSet& x = sets[d];
+            int need = required_overlap(x.total, threshold);
+            int remaining = x.total;
+            int prefix = 0;
+            while (remaining >= need) {
+                remaining -= x.counts[prefix];
+                ++prefix;
+            }
+            return prefix;
+        }
+
+        // Finds the documents in which threshold of document d's n-grams
+        // appear, adding each pair to found unless the other document will
+        // report it itself. matched (zero for every document) and touched are
+        // scratch space, left as they were found. Returns the number of
+        // candidates verified.
+        long probe(int d,
+                   std::vector<int>& matched,
+                   std::vector<int>& touched,
+                   std::vector<JoinedPair>& found) const {
+            const NGramSet& x = sets[d];
+            int size = x.ids.size();
+            int need = required_overlap(x.total, threshold);
+
+            // the weight and the largest count of the n-grams from each
+            // position on.
+            std::vector<int> suffix(size + 1, 0);
+            std::vector<int> largest(size + 1, 0);
+            for (int i = size - 1; i >= 0; --i) {
+                suffix[i] = suffix[i + 1] + x.counts[i];
+                largest[i] = std::max(largest[i + 1], x.counts[i]);
+            }
+
+            // the fewest distinct n-grams that can hold need of x's.
+            std::vector<int> counts(x.counts);
+            std::sort(counts.begin(), counts.end(), std::greater<int>());
+            int min_size = 0;
+            for (int held = 0; held < need; ++min_size) {
+                held += counts[min_size];
+            }
+
+            int prefix = prefix_length(d);
+            touched.clear();
+            for (int i = 0; i < prefix; ++i) {
+                const std::vector<Posting>& list = postings[x.ids[i]];
+                for (size_t p = 0; p < list.size(); ++p) {
+                    int b = list[p].document;
+                    int b_size = sets[b].ids.size();
+                    if (b == d || b_size < min_size || matched[b] < 0) {
+                        continue;
+                    }
+                    if (matched[b] == 0) {
+                        touched.push_back(b);
+                    }
+                    matched[b] += x.counts[i];
+                    long rest = b_size - list[p].position - 1;
+                    long bound = matched[b] + std::min(long(suffix[i + 1]),
+                                                       rest * largest[i + 1]);
+                    if (bound < need) {
+                        matched[b] = -1;
+                    }
+                }
+            }
+
+            long verified = 0;
+            for (size_t k = 0; k < touched.size(); ++k) {
+                int b = touched[k];
+                if (matched[b] > 0) {
+                    ++verified;
+                    int in_x = 0;
+                    int in_b = 0;
+                    overlap_counts(x, sets[b], in_x, in_b);
+                    bool b_reports = b < d &&
+                        in_b >= required_overlap(sets[b].total, threshold);
+                    if (in_x >= need && !b_reports) {
+                        double x_in_b = double(in_x) / x.total;
+                        double b_in_x = double(in_b) / sets[b].total;
+                        JoinedPair pair = {std::min(d, b), std::max(d, b),
+                                           d < b ? x_in_b : b_in_x,
+                                           d < b ? b_in_x : x_in_b};
+                        found.push_back(pair);
+                    }
+                }
+                matched[b] = 0;
+            }
+            return verified;
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef SPEEDREADER_STRING_NGRAMS_H
+#define SPEEDREADER_STRING_NGRAMS_H
+
+#include <string>
+#include <vector>
+#include <algorithm>
+
+namespace mjd {
+
+    // The n-grams String_Input_Sequential_String_Set_Hash_Comparison() forms
+    // from a document: its tokens are split on single spaces, and the
+    // ngram_length tokens starting at each of the first n - ngram_length + 1
+    // positions are concatenated (or all n tokens, if there are fewer than
+    // ngram_length).
+    inline void string_sequence_ngrams(const std::string& text,
+                                       int ngram_length,
+                                       std::vector<std::string>& ngrams) {
+        std::vector<std::string> tokens;
+        size_t start = 0;
+        while (true) {
+            size_t space = text.find(' ', start);
+            if (space == std::string::npos) {
+                tokens.push_back(text.substr(start));
+                break;
+            }
+            tokens.push_back(text.substr(start, space - start));
+            start = space + 1;
+        }
+        size_t width = std::min(tokens.size(), size_t(std::max(1, ngram_length)));
+        size_t count = tokens.size() - width + 1;
+        ngrams.resize(count);
+        for (size_t k = 0; k < count; ++k) {
+            ngrams[k] = tokens[k];
+            for (size_t l = 1; l < width; ++l) {
+                ngrams[k] += tokens[k + l];
+            }
+        }
+    }
+
+}
+
+#endif
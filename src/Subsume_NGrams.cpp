@@ -0,0 +1,189 @@
+// [[Rcpp::plugins(cpp11)]]
+#include <RcppArmadillo.h>
+#include <string>
+#include <cmath>
+#include <algorithm>
+#include "Aho_Corasick.h"
+//[[Rcpp::depends(RcppArmadillo)]]
+using namespace Rcpp;
+
+// Greedily clusters ranked terms with the terms that contain them, or that
+// they (or those containing terms) contain, among the top_terms_to_search
+// remaining terms, keeping those whose document counts correlate with the
+// focal term above correlation_threshold. Containment between all terms is
+// found up front with an Aho-Corasick automaton, and correlations come from
+// sparse columns (one based triplets i, j, v with column k for term k) with
+// precomputed sums and sums of squares. Returns one list(members,
+// correlations, in_cluster) per cluster, with one based term indices and the
+// focal term first.
+// [[Rcpp::export]]
+List Subsume_NGrams(std::vector<std::string> terms,
+                    IntegerVector i,
+                    IntegerVector j,
+                    NumericVector v,
+                    int num_rows,
+                    int term_clusters_to_output,
+                    int top_terms_to_search,
+                    double correlation_threshold){
+
+    int num_terms = terms.size();
+
+    // contained[t] lists the terms that are substrings of term t (including
+    // itself), and containers[t] the terms t is a substring of.
+    std::vector<std::vector<int> > contained(num_terms);
+    std::vector<std::vector<int> > containers(num_terms);
+    mjd::AhoCorasick automaton(terms);
+    for (int t = 0; t < num_terms; ++t) {
+        automaton.find_all(terms[t], [&](int pattern) {
+            contained[t].push_back(pattern);
+        });
+        std::sort(contained[t].begin(), contained[t].end());
+        contained[t].erase(std::unique(contained[t].begin(), contained[t].end()),
+                           contained[t].end());
+        for (size_t k = 0; k < contained[t].size(); ++k) {
+            containers[contained[t][k]].push_back(t);
+        }
+    }
+
+    // sparse columns, with their sums and sums of squares.
+    std::vector<std::vector<std::pair<int, double> > > columns(num_terms);
+    std::vector<double> sums(num_terms, 0);
+    std::vector<double> squares(num_terms, 0);
+    int num_entries = i.size();
+    for (int k = 0; k < num_entries; ++k) {
+        if (i[k] < 1 || i[k] > num_rows || j[k] < 1 || j[k] > num_terms) {
+            Rcpp::stop("The document term matrix has an entry outside of its dimensions.");
+        }
+        int column = j[k] - 1;
+        columns[column].push_back(std::make_pair(i[k] - 1, v[k]));
+        sums[column] += v[k];
+        squares[column] += v[k] * v[k];
+    }
+    double n = num_rows;
+
+    // remaining terms in rank order, and each one's rank while it is inside
+    // the search window (0 if it is not).
+    std::vector<int> remaining(num_terms);
+    for (int t = 0; t < num_terms; ++t) {
+        remaining[t] = t;
+    }
+    std::vector<int> window_rank(num_terms, 0);
+    std::vector<double> focal_column(num_rows, 0);
+    std::vector<char> in_cluster(num_terms, 0);
+
+    std::vector<List> found;
+    for (int c = 0; c < term_clusters_to_output; ++c) {
+        int max_row = std::min<int>(top_terms_to_search, remaining.size());
+        if (max_row == 0) {
+            break;
+        }
+        for (int r = 0; r < max_row; ++r) {
+            window_rank[remaining[r]] = r + 1;
+        }
+        int focal = remaining[0];
+
+        // terms containing the focal term, then every term contained in one of
+        // those (or the focal term), each in rank order.
+        std::vector<int> members(1, focal);
+        std::vector<std::pair<int, int> > ranked;
+        for (size_t k = 0; k < containers[focal].size(); ++k) {
+            int t = containers[focal][k];
+            if (window_rank[t] > 1) {
+                ranked.push_back(std::make_pair(window_rank[t], t));
+            }
+        }
+        std::sort(ranked.begin(), ranked.end());
+        for (size_t k = 0; k < ranked.size(); ++k) {
+            members.push_back(ranked[k].second);
+        }
+        std::vector<int> larger_terms(members);
+        for (size_t l = 0; l < larger_terms.size(); ++l) {
+            int cur = larger_terms[l];
+            ranked.clear();
+            for (size_t k = 0; k < contained[cur].size(); ++k) {
+                int t = contained[cur][k];
+                if (window_rank[t] > 1) {
+                    ranked.push_back(std::make_pair(window_rank[t], t));
+                }
+            }
+            std::sort(ranked.begin(), ranked.end());
+            for (size_t k = 0; k < ranked.size(); ++k) {
+                members.push_back(ranked[k].second);
+            }
+        }
+        std::vector<int> unique_members;
+        for (size_t k = 0; k < members.size(); ++k) {
+            if (!in_cluster[members[k]]) {
+                in_cluster[members[k]] = 1;
+                unique_members.push_back(members[k]);
+            }
+        }
+
+        // Pearson correlations with the focal term; constant columns count
+        // as perfectly correlated.
+        NumericVector correlations(unique_members.size());
+        IntegerVector in_cluster_indicator(unique_members.size());
+        correlations[0] = 1;
+        in_cluster_indicator[0] = 1;
+        if (unique_members.size() > 1) {
+            in_cluster_indicator[0] = 1 > correlation_threshold;
+            for (size_t k = 0; k < columns[focal].size(); ++k) {
+                focal_column[columns[focal][k].first] += columns[focal][k].second;
+            }
+            for (size_t m = 1; m < unique_members.size(); ++m) {
+                int t = unique_members[m];
+                double dot = 0;
+                for (size_t k = 0; k < columns[t].size(); ++k) {
+                    dot += focal_column[columns[t][k].first] * columns[t][k].second;
+                }
+                double covariance = n * dot - sums[focal] * sums[t];
+                double variance_focal = n * squares[focal] - sums[focal] * sums[focal];
+                double variance_t = n * squares[t] - sums[t] * sums[t];
+                double correlation = 1;
+                if (variance_focal > 0 && variance_t > 0) {
+                    correlation = covariance / std::sqrt(variance_focal * variance_t);
+                }
+                correlations[m] = correlation;
+                in_cluster_indicator[m] = correlation > correlation_threshold;
+            }
+            for (size_t k = 0; k < columns[focal].size(); ++k) {
+                focal_column[columns[focal][k].first] = 0;
+            }
+        }
+
+        IntegerVector member_indices(unique_members.size());
+        for (size_t m = 0; m < unique_members.size(); ++m) {
+            in_cluster[unique_members[m]] = in_cluster_indicator[m];
+            member_indices[m] = unique_members[m] + 1;
+        }
+        for (int r = 0; r < max_row; ++r) {
+            window_rank[remaining[r]] = 0;
+        }
+        // drop the clustered terms, keeping the rest in rank order.
+        size_t kept = 0;
+        for (size_t r = 0; r < remaining.size(); ++r) {
+            if (!in_cluster[remaining[r]]) {
+                remaining[kept++] = remaining[r];
+            }
+        }
+        remaining.resize(kept);
+        for (size_t m = 0; m < unique_members.size(); ++m) {
+            in_cluster[unique_members[m]] = 0;
+        }
+
+        List cluster(3);
+        cluster[0] = member_indices;
+        cluster[1] = correlations;
+        cluster[2] = in_cluster_indicator;
+        found.push_back(cluster);
+        if (remaining.empty()) {
+            break;
+        }
+    }
+
+    List to_return(found.size());
+    for (size_t c = 0; c < found.size(); ++c) {
+        to_return[c] = found[c];
+    }
+    return to_return;
+}
@@ -0,0 +1,193 @@
+#ifndef SPEEDREADER_SUFFIX_AUTOMATON_H
+#define SPEEDREADER_SUFFIX_AUTOMATON_H
+
+#include <vector>
+#include <map>
+#include <cstddef>
+
+namespace mjd {
+
+    // Suffix automaton over a sequence of token ids. Every substring of the
+    // sequence corresponds to a path from the root, so another sequence can
+    // be streamed through it to find, at each position, the longest suffix
+    // that occurs somewhere in this one. Built in linear time (Blumer et al.).
+    class SuffixAutomaton {
+    public:
+        explicit SuffixAutomaton(const std::vector<int>& s) {
+            states.reserve(2 * s.size() + 1);
+            states.push_back(State());
+            int last = 0;
+            for (size_t i = 0; i < s.size(); ++i) {
+                int token = s[i];
+                int cur = states.size();
+                states.push_back(State());
+                states[cur].length = states[last].length + 1;
+                states[cur].first_end = i;
+                int p = last;
+                while (p != -1 && states[p].next.count(token) == 0) {
+                    states[p].next[token] = cur;
+                    p = states[p].link;
+                }
+                if (p == -1) {
+                    states[cur].link = 0;
+                } else {
+                    int q = states[p].next[token];
+                    if (states[p].length + 1 == states[q].length) {
+                        states[cur].link = q;
+                    } else {
+                        int clone = states.size();
+                        states.push_back(states[q]);
+                        states[clone].length = states[p].length + 1;
+                        while (p != -1 && states[p].next[token] == q) {
+                            states[p].next[token] = clone;
+                            p = states[p].link;
+                        }
+                        states[q].link = clone;
+                        states[cur].link = clone;
+                    }
+                }
+                last = cur;
+            }
+        }
+
+        // lengths[i] is the length of the longest suffix of t[0..i] that
+        // occurs in the automaton's sequence, and ends[i] the (zero based)
+        // position at which its first occurrence there ends.
+        void match(const std::vector<int>& t,
+                   std::vector<int>& lengths,
+                   std::vector<int>& ends) const {
+            lengths.assign(t.size(), 0);
+            ends.assign(t.size(), -1);
+            int state = 0;
+            int length = 0;
+            for (size_t i = 0; i < t.size(); ++i) {
+                while (state != 0 && states[state].next.count(t[i]) == 0) {
+                    state = states[state].link;
+                    length = states[state].length;
+                }
+                std::map<int, int>::const_iterator edge =
+                    states[state].next.find(t[i]);
+                if (edge != states[state].next.end()) {
+                    state = edge->second;
+                    length += 1;
+                    ends[i] = states[state].first_end;
+                }
+                lengths[i] = length;
+            }
+        }
+
+    private:
+        struct State {
+            int length;
+            int link;
+            int first_end;
+            std::map<int, int> next;
+            State() : length(0), link(-1), first_end(-1) {}
+        };
+        std::vector<State> states;
+    };
+
+    // Which n-grams of one document appear in another, using the n-grams
+    // Sequential_Raw_Term_Dice_Matches() always has: unigrams for sizes of one
+    // or less; otherwise the n - 1 token windows starting at the first
+    // L - n + 1 positions, or every unigram if the document has no more than
+    // n - 1 tokens.
+    class SequenceMatcher {
+    public:
+        SequenceMatcher(const std::vector<int>& a, const std::vector<int>& b)
+            : a(a), b(b) {
+            stream(a, b, in_b, in_b_prefix, ends_in_b);
+            std::vector<int> ends_in_a;
+            stream(b, a, in_a, in_a_prefix, ends_in_a);
+        }
+
+        std::vector<double> which_a_in_b(int ngram_size) const {
+            return mask(a, b, in_b, in_b_prefix, ngram_size);
+        }
+
+        std::vector<double> which_b_in_a(int ngram_size) const {
+            return mask(b, a, in_a, in_a_prefix, ngram_size);
+        }
+
+        // Maximal exact matches of a in b: every position where the longest
+        // match ending there cannot be extended to the right. Positions are
+        // zero based starts in a and in (the first occurrence in) b.
+        void matching_blocks(int minimum_length,
+                             std::vector<int>& a_starts,
+                             std::vector<int>& b_starts,
+                             std::vector<int>& lengths) const {
+            for (size_t i = 0; i < a.size(); ++i) {
+                int length = in_b[i];
+                if (length < minimum_length || length < 1) {
+                    continue;
+                }
+                if (i + 1 < a.size() && in_b[i + 1] == length + 1) {
+                    continue;
+                }
+                a_starts.push_back(i - length + 1);
+                b_starts.push_back(ends_in_b[i] - length + 1);
+                lengths.push_back(length);
+            }
+        }
+
+    private:
+        // matching lengths of x against all of y and against y without its
+        // last token (the only positions windows are taken from).
+        static void stream(const std::vector<int>& x,
+                           const std::vector<int>& y,
+                           std::vector<int>& full,
+                           std::vector<int>& prefix,
+                           std::vector<int>& ends) {
+            SuffixAutomaton(y).match(x, full, ends);
+            std::vector<int> prefix_ends;
+            std::vector<int> y_prefix(y.begin(), y.end() - (y.empty() ? 0 : 1));
+            SuffixAutomaton(y_prefix).match(x, prefix, prefix_ends);
+        }
+
+        static std::vector<double> mask(const std::vector<int>& x,
+                                        const std::vector<int>& y,
+                                        const std::vector<int>& full,
+                                        const std::vector<int>& prefix,
+                                        int ngram_size) {
+            int lx = x.size();
+            int ly = y.size();
+            int window = ngram_size - 1;
+            bool short_x = ngram_size > 1 && lx <= window;
+            bool short_y = ngram_size > 1 && ly <= window;
+            std::vector<double> matches;
+            if (ngram_size <= 1 || short_x) {
+                // unigrams of x against y's unigrams, or y's one token
+                // windows when n = 2.
+                matches.resize(lx);
+                for (int p = 0; p < lx; ++p) {
+                    if (ngram_size <= 1 || short_y) {
+                        matches[p] = full[p] >= 1;
+                    } else {
+                        matches[p] = window == 1 && prefix[p] >= 1;
+                    }
+                }
+                return matches;
+            }
+            matches.resize(lx - window);
+            for (int p = 0; p < lx - window; ++p) {
+                if (short_y) {
+                    matches[p] = window == 1 && full[p] >= 1;
+                } else {
+                    matches[p] = prefix[p + window - 1] >= window;
+                }
+            }
+            return matches;
+        }
+
+        std::vector<int> a;
+        std::vector<int> b;
+        std::vector<int> in_b;
+        std::vector<int> in_b_prefix;
+        std::vector<int> ends_in_b;
+        std::vector<int> in_a;
+        std::vector<int> in_a_prefix;
+    };
+
+}
+
+#endif
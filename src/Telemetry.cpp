@@ -0,0 +1,62 @@
+// [[Rcpp::plugins(cpp11)]]
+#include <RcppArmadillo.h>
+#include <string>
+#include "Telemetry.h"
+//[[Rcpp::depends(RcppArmadillo)]]
+using namespace Rcpp;
+
+namespace mjd {
+    void rcout_sink(const std::string& message) {
+        Rcpp::Rcout << message << std::endl;
+    }
+
+    // route progress messages to the R console as soon as the package loads.
+    struct InstallTelemetrySink {
+        InstallTelemetrySink() {
+            telemetry().set_sink(rcout_sink);
+        }
+    };
+    InstallTelemetrySink install_telemetry_sink;
+}
+
+// Returns the counters (names, values) and phases (names, calls, wall
+// seconds, CPU seconds) recorded by the kernels since the last reset.
+// [[Rcpp::export]]
+List Telemetry_Report(){
+    std::vector<std::string> counter_names;
+    std::vector<double> counter_values;
+    mjd::telemetry().counter_values(counter_names, counter_values);
+
+    std::vector<std::string> phase_names;
+    std::vector<double> calls;
+    std::vector<double> wall_seconds;
+    std::vector<double> cpu_seconds;
+    mjd::telemetry().phase_values(phase_names, calls, wall_seconds, cpu_seconds);
+
+    List counters(2);
+    counters[0] = counter_names;
+    counters[1] = counter_values;
+    List phases(4);
+    phases[0] = phase_names;
+    phases[1] = calls;
+    phases[2] = wall_seconds;
+    phases[3] = cpu_seconds;
+
+    List to_return(2);
+    to_return[0] = counters;
+    to_return[1] = phases;
+    return to_return;
+}
+
+// [[Rcpp::export]]
+void Telemetry_Reset(){
+    mjd::telemetry().reset();
+}
+
+// Turns progress messages on or off and sets the minimum number of seconds
+// between them.
+// [[Rcpp::export]]
+void Telemetry_Options(bool verbose,
+                       double progress_interval){
+    mjd::telemetry().set_progress(verbose, progress_interval);
+}
@@ -0,0 +1,234 @@
+#ifndef SPEEDREADER_TELEMETRY_H
+#define SPEEDREADER_TELEMETRY_H
+
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace mjd {
+
+    // Process wide instrumentation shared by every kernel: named atomic
+    // counters, per-phase wall and CPU timers, and rate limited progress
+    // messages. Counters and phases are registered once by name and then
+    // updated lock free, so they can be used from worker threads. Messages
+    // go to a sink installed by the R side (Telemetry.cpp), and must only be
+    // sent from the thread R called into.
+    class Telemetry {
+    public:
+        typedef void (*Sink)(const std::string& message);
+
+        struct Counter {
+            std::string name;
+            std::atomic<uint64_t> value;
+        };
+
+        struct Phase {
+            std::string name;
+            std::atomic<uint64_t> calls;
+            std::atomic<uint64_t> wall_nanoseconds;
+            std::atomic<uint64_t> cpu_nanoseconds;
+        };
+
+        Telemetry() : sink(0), verbose(true), interval_seconds(1) {}
+
+        // The counter called name, created at zero the first time. The
+        // reference stays valid for the life of the process.
+        std::atomic<uint64_t>& counter(const std::string& name) {
+            std::lock_guard<std::mutex> lock(registry);
+            for (size_t k = 0; k < counters.size(); ++k) {
+                if (counters[k].name == name) {
+                    return counters[k].value;
+                }
+            }
+            counters.emplace_back();
+            counters.back().name = name;
+            counters.back().value = 0;
+            return counters.back().value;
+        }
+
+        Phase& phase(const std::string& name) {
+            std::lock_guard<std::mutex> lock(registry);
+            for (size_t k = 0; k < phases.size(); ++k) {
+                if (phases[k].name == name) {
+                    return phases[k];
+                }
+            }
+            phases.emplace_back();
+            Phase& added = phases.back();
+            added.name = name;
+            added.calls = 0;
+            added.wall_nanoseconds = 0;
+            added.cpu_nanoseconds = 0;
+            return added;
+        }
+
+        // Zeroes every counter and phase, keeping their registrations.
+        void reset() {
+            std::lock_guard<std::mutex> lock(registry);
+            for (size_t k = 0; k < counters.size(); ++k) {
+                counters[k].value = 0;
+            }
+            for (size_t k = 0; k < phases.size(); ++k) {
+                phases[k].calls = 0;
+                phases[k].wall_nanoseconds = 0;
+                phases[k].cpu_nanoseconds = 0;
+            }
+        }
+
+        void counter_values(std::vector<std::string>& names,
+                            std::vector<double>& values) {
+            std::lock_guard<std::mutex> lock(registry);
+            for (size_t k = 0; k < counters.size(); ++k) {
+                names.push_back(counters[k].name);
+                values.push_back(counters[k].value.load());
+            }
+        }
+
+        void phase_values(std::vector<std::string>& names,
+                          std::vector<double>& calls,
+                          std::vector<double>& wall_seconds,
+                          std::vector<double>& cpu_seconds) {
+            std::lock_guard<std::mutex> lock(registry);
+            for (size_t k = 0; k < phases.size(); ++k) {
+                names.push_back(phases[k].name);
+                calls.push_back(phases[k].calls.load());
+                wall_seconds.push_back(phases[k].wall_nanoseconds.load() * 1e-9);
+                cpu_seconds.push_back(phases[k].cpu_nanoseconds.load() * 1e-9);
+            }
+        }
+
+        void set_sink(Sink s) {
+            sink = s;
+        }
+
+        void set_progress(bool print, double seconds) {
+            verbose = print;
+            interval_seconds = seconds;
+        }
+
+        bool printing() const {
+            return verbose && sink != 0;
+        }
+
+        double interval() const {
+            return interval_seconds;
+        }
+
+        void print(const std::string& message) {
+            if (printing()) {
+                sink(message);
+            }
+        }
+
+    private:
+        Telemetry(const Telemetry&);
+        Telemetry& operator=(const Telemetry&);
+
+        // deques, so references handed out stay valid as entries are added.
+        std::mutex registry;
+        std::deque<Counter> counters;
+        std::deque<Phase> phases;
+        Sink sink;
+        bool verbose;
+        double interval_seconds;
+    };
+
+    inline Telemetry& telemetry() {
+        static Telemetry instance;
+        return instance;
+    }
+
+    // Adds the wall clock and process CPU time between construction and
+    // destruction (or stop()) to the named phase.
+    class PhaseTimer {
+    public:
+        explicit PhaseTimer(const std::string& name)
+            : phase(telemetry().phase(name)),
+              wall_start(std::chrono::steady_clock::now()),
+              cpu_start(std::clock()),
+              stopped(false) {}
+
+        ~PhaseTimer() {
+            stop();
+        }
+
+        // Ends the phase early; later calls do nothing.
+        void stop() {
+            if (stopped) {
+                return;
+            }
+            stopped = true;
+            std::chrono::steady_clock::duration wall =
+                std::chrono::steady_clock::now() - wall_start;
+            double cpu = double(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+            phase.calls += 1;
+            phase.wall_nanoseconds += std::chrono::duration_cast<
+                std::chrono::nanoseconds>(wall).count();
+            phase.cpu_nanoseconds += uint64_t(cpu * 1e9);
+        }
+
+    private:
+        PhaseTimer(const PhaseTimer&);
+        PhaseTimer& operator=(const PhaseTimer&);
+
+        Telemetry::Phase& phase;
+        std::chrono::steady_clock::time_point wall_start;
+        std::clock_t cpu_start;
+        bool stopped;
+    };
+
+    // Progress through a loop of total items, printed as "label: done of
+    // total" at most once per telemetry().interval() seconds, plus once at
+    // the end. Only call update() from the thread R called into.
+    class Progress {
+    public:
+        Progress(const std::string& label, uint64_t total)
+            : label(label),
+              total(total),
+              printed(false),
+              last(std::chrono::steady_clock::now()) {}
+
+        void update(uint64_t done) {
+            if (!telemetry().printing()) {
+                return;
+            }
+            std::chrono::steady_clock::time_point now =
+                std::chrono::steady_clock::now();
+            if (std::chrono::duration<double>(now - last).count() <
+                telemetry().interval()) {
+                return;
+            }
+            last = now;
+            report(done);
+        }
+
+        // Prints the final count if any progress was shown.
+        void finish() {
+            if (printed) {
+                report(total);
+            }
+        }
+
+    private:
+        void report(uint64_t done) {
+            std::ostringstream message;
+            message << label << ": " << done << " of " << total;
+            telemetry().print(message.str());
+            printed = true;
+        }
+
+        std::string label;
+        uint64_t total;
+        bool printed;
+        std::chrono::steady_clock::time_point last;
+    };
+
+}
+
+#endif
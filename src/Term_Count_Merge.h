@@ -0,0 +1,112 @@
+#ifndef SPEEDREADER_TERM_COUNT_MERGE_H
+#define SPEEDREADER_TERM_COUNT_MERGE_H
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include "Parallel.h"
+#include "Vocabulary.h"
+
+namespace mjd {
+
+    // Term counts sorted by term. first is where each term was first seen
+    // (block * 2^32 + position in the block's first-seen order), so merged
+    // runs can still be put back in corpus wide first-seen order.
+    struct TermCountRun {
+        std::vector<std::string> terms;
+        std::vector<double> counts;
+        std::vector<double> first;
+
+        size_t size() const {
+            return terms.size();
+        }
+
+        void push_back(const std::string& term, double count, double seen) {
+            terms.push_back(term);
+            counts.push_back(count);
+            first.push_back(seen);
+        }
+    };
+
+    // A run from terms interned in first-seen order with their counts.
+    inline TermCountRun sorted_term_counts(const Vocabulary& vocabulary,
+                                           const std::vector<double>& counts,
+                                           int block) {
+        std::vector<int> order(vocabulary.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](int a, int b) {
+            return vocabulary.term(a) < vocabulary.term(b);
+        });
+        TermCountRun run;
+        run.terms.reserve(order.size());
+        run.counts.reserve(order.size());
+        run.first.reserve(order.size());
+        for (size_t k = 0; k < order.size(); ++k) {
+            run.push_back(vocabulary.term(order[k]), counts[order[k]],
+                          double(block) * 4294967296.0 + order[k]);
+        }
+        return run;
+    }
+
+    // Linear merge of two runs, adding the counts of shared terms.
+    inline TermCountRun merge_term_counts(const TermCountRun& a,
+                                          const TermCountRun& b) {
+        TermCountRun merged;
+        merged.terms.reserve(a.size() + b.size());
+        merged.counts.reserve(a.size() + b.size());
+        merged.first.reserve(a.size() + b.size());
+        size_t i = 0;
+        size_t j = 0;
+        while (i < a.size() && j < b.size()) {
+            int compare = a.terms[i].compare(b.terms[j]);
+            if (compare < 0) {
+                merged.push_back(a.terms[i], a.counts[i], a.first[i]);
+                ++i;
+            } else if (compare > 0) {
+                merged.push_back(b.terms[j], b.counts[j], b.first[j]);
+                ++j;
+            } else {
+                merged.push_back(a.terms[i], a.counts[i] + b.counts[j],
+                                 std::min(a.first[i], b.first[j]));
+                ++i;
+                ++j;
+            }
+        }
+        for (; i < a.size(); ++i) {
+            merged.push_back(a.terms[i], a.counts[i], a.first[i]);
+        }
+        for (; j < b.size(); ++j) {
+            merged.push_back(b.terms[j], b.counts[j], b.first[j]);
+        }
+        return merged;
+    }
+
+    // Merges runs pairwise, level by level, with the pairs at each level
+    // merged in parallel, so k runs take log2(k) rounds.
+    inline TermCountRun tree_merge_term_counts(std::vector<TermCountRun> runs,
+                                               int cores) {
+        if (runs.empty()) {
+            return TermCountRun();
+        }
+        while (runs.size() > 1) {
+            int pairs = runs.size() / 2;
+            std::vector<TermCountRun> next((runs.size() + 1) / 2);
+            parallel_for(pairs, cores, [&](int start, int end, int t) {
+                for (int p = start; p < end; ++p) {
+                    next[p] = merge_term_counts(runs[2 * p], runs[2 * p + 1]);
+                    runs[2 * p] = TermCountRun();
+                    runs[2 * p + 1] = TermCountRun();
+                }
+            });
+            if (runs.size() % 2 == 1) {
+                std::swap(next.back(), runs.back());
+            }
+            runs.swap(next);
+        }
+        return runs[0];
+    }
+
+}
+
+#endif
@@ -0,0 +1,256 @@
+// [[Rcpp::plugins(cpp11)]]
+#include <RcppArmadillo.h>
+#include <string>
+#include "Block_File.h"
+#include "Term_Sketch.h"
+#include "Vocabulary.h"
+#include "Parallel.h"
+#include "Telemetry.h"
+//[[Rcpp::depends(RcppArmadillo)]]
+using namespace Rcpp;
+
+namespace mjd {
+    CharacterVector utf8_character_vector(const std::vector<std::string>& v);
+    void stop_on_error(const std::vector<std::string>& errors);
+
+    TermSketch& term_sketch_reference(SEXP pointer) {
+        if (TYPEOF(pointer) != EXTPTRSXP) {
+            Rcpp::stop("Expected a term sketch created by Create_Term_Sketch().");
+        }
+        XPtr<TermSketch> sketch(pointer);
+        if (sketch.get() == NULL) {
+            Rcpp::stop("This term sketch is no longer in memory.");
+        }
+        return *sketch;
+    }
+
+    // the heavy hitter table as (terms, counts, lower bounds on the counts).
+    List heavy_hitter_list(const SpaceSaving& heavy) {
+        std::vector<SpaceSaving::Entry> entries = heavy.heaviest();
+        std::vector<std::string> terms(entries.size());
+        NumericVector counts(entries.size());
+        NumericVector lower_bounds(entries.size());
+        for (size_t k = 0; k < entries.size(); ++k) {
+            terms[k] = entries[k].term;
+            counts[k] = entries[k].count;
+            lower_bounds[k] = entries[k].count - entries[k].error;
+        }
+        List to_return(3);
+        to_return[0] = utf8_character_vector(terms);
+        to_return[1] = counts;
+        to_return[2] = lower_bounds;
+        return to_return;
+    }
+
+    // total count of every string in a block's string table.
+    void block_string_counts(const BlockReader& block,
+                             std::vector<double>& counts) {
+        counts.assign(block.num_strings(), 0);
+        for (size_t i = 0; i < block.num_documents(); ++i) {
+            size_t length = block.document_length(i);
+            const uint32_t* ids = block.document_ids(i);
+            const double* weights = block.document_counts(i);
+            for (size_t k = 0; k < length; ++k) {
+                counts[ids[k]] += weights == 0 ? 1 : weights[k];
+            }
+        }
+    }
+}
+
+// Counts only the terms that appear at least threshold times in a set of
+// document term blocks, in two passes. The first builds a Count-Min sketch
+// and heavy hitter table per thread and merges them; the second counts
+// exactly only the terms whose sketch estimate reaches the threshold, so
+// memory grows with the surviving vocabulary rather than the long tail.
+// Returns the surviving terms (in first-seen order) and their counts, the
+// number of candidates counted exactly, and the heavy hitter table.
+// [[Rcpp::export]]
+List Block_Count_Frequent_Words(std::vector<std::string> files,
+                                double threshold,
+                                int sketch_width,
+                                int sketch_depth,
+                                int heavy_hitters,
+                                int cores){
+
+    int num_files = files.size();
+    int ranges = mjd::parallel_ranges(num_files, cores);
+    std::vector<std::string> errors(ranges);
+
+    mjd::PhaseTimer sketching("Block_Count_Frequent_Words.sketching");
+    std::vector<mjd::TermSketch> sketches(
+        ranges, mjd::TermSketch(sketch_width, sketch_depth, heavy_hitters));
+    mjd::parallel_for(num_files, cores, [&](int start, int end, int t) {
+        std::vector<double> counts;
+        for (int f = start; f < end; ++f) {
+            mjd::BlockReader block;
+            if (!block.open(files[f], errors[t])) {
+                return;
+            }
+            mjd::block_string_counts(block, counts);
+            for (size_t k = 0; k < block.num_strings(); ++k) {
+                if (counts[k] > 0) {
+                    sketches[t].add(block.term_data(k), block.term_length(k),
+                                    counts[k]);
+                }
+            }
+        }
+    });
+    mjd::stop_on_error(errors);
+    for (int t = 1; t < ranges; ++t) {
+        sketches[0].merge(sketches[t]);
+    }
+    sketches.erase(sketches.begin() + 1, sketches.end());
+    const mjd::TermSketch& sketch = sketches[0];
+    sketching.stop();
+
+    mjd::PhaseTimer counting("Block_Count_Frequent_Words.counting");
+    std::vector<mjd::Vocabulary> local_vocabularies(ranges);
+    std::vector<std::vector<double> > local_counts(ranges);
+    mjd::parallel_for(num_files, cores, [&](int start, int end, int t) {
+        mjd::Vocabulary& vocabulary = local_vocabularies[t];
+        std::vector<double>& totals = local_counts[t];
+        std::vector<double> counts;
+        for (int f = start; f < end; ++f) {
+            mjd::BlockReader block;
+            if (!block.open(files[f], errors[t])) {
+                return;
+            }
+            mjd::block_string_counts(block, counts);
+            for (size_t k = 0; k < block.num_strings(); ++k) {
+                if (counts[k] == 0 ||
+                    !sketch.candidate(block.term_data(k), block.term_length(k),
+                                      threshold)) {
+                    continue;
+                }
+                int id = vocabulary.intern(block.term(k));
+                if (id == int(totals.size())) {
+                    totals.push_back(0);
+                }
+                totals[id] += counts[k];
+            }
+        }
+    });
+    mjd::stop_on_error(errors);
+
+    mjd::Vocabulary vocabulary;
+    std::vector<std::vector<int> > remaps = vocabulary.merge(local_vocabularies);
+    std::vector<double> word_counts(vocabulary.size(), 0);
+    for (int t = 0; t < ranges; ++t) {
+        for (size_t k = 0; k < remaps[t].size(); ++k) {
+            word_counts[remaps[t][k]] += local_counts[t][k];
+        }
+    }
+    std::vector<std::string> terms;
+    std::vector<double> counts;
+    for (int id = 0; id < vocabulary.size(); ++id) {
+        if (word_counts[id] >= threshold) {
+            terms.push_back(vocabulary.term(id));
+            counts.push_back(word_counts[id]);
+        }
+    }
+    mjd::telemetry().counter("Block_Count_Frequent_Words.candidates") += vocabulary.size();
+
+    List to_return(4);
+    to_return[0] = mjd::utf8_character_vector(terms);
+    to_return[1] = NumericVector(counts.begin(), counts.end());
+    to_return[2] = vocabulary.size();
+    to_return[3] = mjd::heavy_hitter_list(sketch.heavy);
+    return to_return;
+}
+
+// A term sketch that blocks of documents held in R can be added to one at a
+// time, for the first pass of a thresholded count over .Rdata blocks.
+// [[Rcpp::export]]
+SEXP Create_Term_Sketch(int sketch_width,
+                        int sketch_depth,
+                        int heavy_hitters){
+    XPtr<mjd::TermSketch> sketch(
+        new mjd::TermSketch(sketch_width, sketch_depth, heavy_hitters), true);
+    return sketch;
+}
+
+// Adds a list of document term vectors (and optional matching counts, or
+// an empty list) to a term sketch. Counts within the block are totalled
+// first so the sketch is updated once per distinct term.
+// [[Rcpp::export]]
+void Term_Sketch_Add(SEXP sketch,
+                     List document_term_vector_list,
+                     List document_term_count_list){
+
+    mjd::TermSketch& current = mjd::term_sketch_reference(sketch);
+    bool using_counts = document_term_count_list.size() > 0;
+    mjd::Vocabulary vocabulary;
+    std::vector<double> counts;
+    int num_docs = document_term_vector_list.size();
+    for (int i = 0; i < num_docs; ++i) {
+        std::vector<std::string> terms =
+            Rcpp::as<std::vector<std::string> >(document_term_vector_list[i]);
+        NumericVector weights;
+        if (using_counts) {
+            weights = document_term_count_list[i];
+        }
+        for (size_t k = 0; k < terms.size(); ++k) {
+            int id = vocabulary.intern(terms[k]);
+            if (id == int(counts.size())) {
+                counts.push_back(0);
+            }
+            counts[id] += using_counts ? weights[k] : 1;
+        }
+    }
+    for (int id = 0; id < vocabulary.size(); ++id) {
+        const std::string& term = vocabulary.term(id);
+        current.add(term.data(), term.size(), counts[id]);
+    }
+}
+
+// Removes every term whose sketch estimate is below threshold from a list
+// of document term vectors (and matching counts), for the exact second
+// pass. Returns the filtered vectors and counts (or NULL).
+// [[Rcpp::export]]
+List Term_Sketch_Filter(SEXP sketch,
+                        List document_term_vector_list,
+                        List document_term_count_list,
+                        double threshold){
+
+    mjd::TermSketch& current = mjd::term_sketch_reference(sketch);
+    bool using_counts = document_term_count_list.size() > 0;
+    int num_docs = document_term_vector_list.size();
+    List documents(num_docs);
+    List document_counts(num_docs);
+    for (int i = 0; i < num_docs; ++i) {
+        std::vector<std::string> terms =
+            Rcpp::as<std::vector<std::string> >(document_term_vector_list[i]);
+        NumericVector weights;
+        if (using_counts) {
+            weights = document_term_count_list[i];
+        }
+        std::vector<std::string> kept_terms;
+        std::vector<double> kept_counts;
+        for (size_t k = 0; k < terms.size(); ++k) {
+            if (current.candidate(terms[k].data(), terms[k].size(), threshold)) {
+                kept_terms.push_back(terms[k]);
+                if (using_counts) {
+                    kept_counts.push_back(weights[k]);
+                }
+            }
+        }
+        documents[i] = mjd::utf8_character_vector(kept_terms);
+        document_counts[i] = NumericVector(kept_counts.begin(),
+                                           kept_counts.end());
+    }
+
+    List to_return(2);
+    to_return[0] = documents;
+    if (using_counts) {
+        to_return[1] = document_counts;
+    } else {
+        to_return[1] = R_NilValue;
+    }
+    return to_return;
+}
+
+// [[Rcpp::export]]
+List Term_Sketch_Heavy_Hitters(SEXP sketch){
+    mjd::TermSketch& current = mjd::term_sketch_reference(sketch);
+    return mjd::heavy_hitter_list(current.heavy);
+}
@@ -0,0 +1,230 @@
+#ifndef SPEEDREADER_TERM_SKETCH_H
+#define SPEEDREADER_TERM_SKETCH_H
+
+#include <string>
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+namespace mjd {
+
+    // 64 bit FNV-1a hash of a term, finished with the splitmix64 mixer so
+    // that every bit depends on every byte.
+    inline uint64_t term_hash(const char* data, size_t length) {
+        uint64_t hash = 14695981039346656037ULL;
+        for (size_t k = 0; k < length; ++k) {
+            hash ^= static_cast<unsigned char>(data[k]);
+            hash *= 1099511628211ULL;
+        }
+        hash ^= hash >> 30;
+        hash *= 0xbf58476d1ce4e5b9ULL;
+        hash ^= hash >> 27;
+        hash *= 0x94d049bb133111ebULL;
+        hash ^= hash >> 31;
+        return hash;
+    }
+
+    // Count-Min sketch of term counts with conservative update: a term's
+    // counters are only raised as far as its new estimate. Estimates never
+    // fall below the true count, and exceed it by more than
+    // 2.72 * total / width with probability at most exp(-depth). Sketches
+    // with the same dimensions merge by adding their counters, which keeps
+    // every estimate an upper bound.
+    class CountMinSketch {
+    public:
+        CountMinSketch(size_t width, int depth)
+            : width(std::max(size_t(1), width)),
+              depth(std::max(1, depth)),
+              counters(this->width * this->depth, 0),
+              total_count(0) {}
+
+        void add(uint64_t hash, double count) {
+            double estimate = find(hash) + count;
+            for (int r = 0; r < depth; ++r) {
+                double& counter = counters[cell(hash, r)];
+                counter = std::max(counter, estimate);
+            }
+            total_count += count;
+        }
+
+        double find(uint64_t hash) const {
+            double estimate = counters[cell(hash, 0)];
+            for (int r = 1; r < depth; ++r) {
+                estimate = std::min(estimate, counters[cell(hash, r)]);
+            }
+            return estimate;
+        }
+
+        void merge(const CountMinSketch& other) {
+            for (size_t k = 0; k < counters.size(); ++k) {
+                counters[k] += other.counters[k];
+            }
+            total_count += other.total_count;
+        }
+
+        double total() const {
+            return total_count;
+        }
+
+    private:
+        // double hashing: row r uses h1 + r * h2, with h2 odd.
+        size_t cell(uint64_t hash, int r) const {
+            uint64_t h2 = (hash >> 32) | 1;
+            return r * width + ((hash + r * h2) % width);
+        }
+
+        size_t width;
+        int depth;
+        std::vector<double> counters;
+        double total_count;
+    };
+
+    // Space-Saving table of the (at most) capacity heaviest terms. Each term
+    // kept has an overestimated count and the most it may be overestimated
+    // by (error), so count - error is a lower bound on its true count.
+    // Tables merge by adding counts, treating a term missing from a full
+    // table as having that table's smallest count.
+    class SpaceSaving {
+    public:
+        struct Entry {
+            std::string term;
+            double count;
+            double error;
+        };
+
+        explicit SpaceSaving(size_t capacity) : capacity(capacity) {}
+
+        void add(const std::string& term, double count) {
+            if (capacity == 0) {
+                return;
+            }
+            std::unordered_map<std::string, size_t>::iterator got =
+                slots.find(term);
+            if (got != slots.end()) {
+                set_count(got->second, entries[got->second].count + count);
+                return;
+            }
+            if (entries.size() < capacity) {
+                Entry entry = {term, count, 0};
+                slots[term] = entries.size();
+                entries.push_back(entry);
+                order.insert(std::make_pair(count, entries.size() - 1));
+                return;
+            }
+            // replace the smallest entry, inheriting its count as error.
+            size_t slot = order.begin()->second;
+            double minimum = entries[slot].count;
+            slots.erase(entries[slot].term);
+            slots[term] = slot;
+            entries[slot].term = term;
+            entries[slot].error = minimum;
+            set_count(slot, minimum + count);
+        }
+
+        void merge(const SpaceSaving& other) {
+            double minimum = full() ? min_count() : 0;
+            double other_minimum = other.full() ? other.min_count() : 0;
+            std::vector<Entry> combined;
+            combined.reserve(entries.size() + other.entries.size());
+            for (size_t k = 0; k < entries.size(); ++k) {
+                Entry entry = entries[k];
+                std::unordered_map<std::string, size_t>::const_iterator got =
+                    other.slots.find(entry.term);
+                if (got != other.slots.end()) {
+                    entry.count += other.entries[got->second].count;
+                    entry.error += other.entries[got->second].error;
+                } else {
+                    entry.count += other_minimum;
+                    entry.error += other_minimum;
+                }
+                combined.push_back(entry);
+            }
+            for (size_t k = 0; k < other.entries.size(); ++k) {
+                if (slots.count(other.entries[k].term) == 0) {
+                    Entry entry = other.entries[k];
+                    entry.count += minimum;
+                    entry.error += minimum;
+                    combined.push_back(entry);
+                }
+            }
+            std::sort(combined.begin(), combined.end(), heavier);
+            if (combined.size() > capacity) {
+                combined.resize(capacity);
+            }
+            entries.clear();
+            slots.clear();
+            order.clear();
+            for (size_t k = 0; k < combined.size(); ++k) {
+                slots[combined[k].term] = k;
+                entries.push_back(combined[k]);
+                order.insert(std::make_pair(combined[k].count, k));
+            }
+        }
+
+        // entries from heaviest to lightest.
+        std::vector<Entry> heaviest() const {
+            std::vector<Entry> sorted(entries);
+            std::sort(sorted.begin(), sorted.end(), heavier);
+            return sorted;
+        }
+
+    private:
+        static bool heavier(const Entry& a, const Entry& b) {
+            if (a.count != b.count) {
+                return a.count > b.count;
+            }
+            return a.term < b.term;
+        }
+
+        bool full() const {
+            return capacity > 0 && entries.size() == capacity;
+        }
+
+        double min_count() const {
+            return order.begin()->first;
+        }
+
+        void set_count(size_t slot, double count) {
+            order.erase(std::make_pair(entries[slot].count, slot));
+            entries[slot].count = count;
+            order.insert(std::make_pair(count, slot));
+        }
+
+        size_t capacity;
+        std::vector<Entry> entries;
+        std::unordered_map<std::string, size_t> slots;
+        std::set<std::pair<double, size_t> > order;
+    };
+
+    // The approximate first pass of a thresholded vocabulary count. Terms
+    // whose sketch estimate reaches the threshold are candidates; every term
+    // that truly reaches it is a candidate, so an exact count of only the
+    // candidates finds the same vocabulary as counting every term.
+    struct TermSketch {
+        TermSketch(size_t width, int depth, size_t heavy_hitters)
+            : counts(width, depth), heavy(heavy_hitters) {}
+
+        void add(const char* data, size_t length, double count) {
+            counts.add(term_hash(data, length), count);
+            heavy.add(std::string(data, length), count);
+        }
+
+        bool candidate(const char* data, size_t length, double threshold) const {
+            return counts.find(term_hash(data, length)) >= threshold;
+        }
+
+        void merge(const TermSketch& other) {
+            counts.merge(other.counts);
+            heavy.merge(other.heavy);
+        }
+
+        CountMinSketch counts;
+        SpaceSaving heavy;
+    };
+
+}
+
+#endif
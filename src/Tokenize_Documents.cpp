@@ -0,0 +1,81 @@
+// [[Rcpp::plugins(cpp11)]]
+#include <RcppArmadillo.h>
+#include <string>
+#include "Tokenizer.h"
+#include "Vocabulary.h"
+#include "Parallel.h"
+//[[Rcpp::depends(RcppArmadillo)]]
+using namespace Rcpp;
+
+namespace mjd {
+    CharacterVector utf8_character_vector(const std::vector<std::string>& v) {
+        CharacterVector out(v.size());
+        for (size_t i = 0; i < v.size(); ++i) {
+            out[i] = Rcpp::String(v[i], CE_UTF8);
+        }
+        return out;
+    }
+}
+
+// [[Rcpp::export]]
+List Tokenize_Documents(
+        std::vector<std::string> documents,
+        std::vector<int> keep_characters,
+        int non_ascii_mode,
+        bool return_ids,
+        int cores){
+
+    int num_docs = documents.size();
+    mjd::Tokenizer tokenizer(keep_characters, non_ascii_mode);
+    List to_return(2);
+    List document_tokens(num_docs);
+
+    if (!return_ids) {
+        std::vector<std::vector<std::string> > tokens(num_docs);
+        mjd::parallel_for(num_docs, cores, [&](int start, int end, int t) {
+            for (int i = start; i < end; ++i) {
+                tokenizer.tokenize(documents[i], tokens[i]);
+            }
+        });
+        for (int i = 0; i < num_docs; ++i) {
+            document_tokens[i] = mjd::utf8_character_vector(tokens[i]);
+            std::vector<std::string>().swap(tokens[i]);
+        }
+        to_return[0] = document_tokens;
+        to_return[1] = CharacterVector();
+        return to_return;
+    }
+
+    // intern into per-thread vocabularies, then merge them in thread order so
+    // ids are assigned in corpus-wide first-seen order.
+    int ranges = mjd::parallel_ranges(num_docs, cores);
+    std::vector<mjd::Vocabulary> local_vocabularies(ranges);
+    std::vector<std::vector<int> > ids(num_docs);
+    std::vector<int> range_of_document(num_docs);
+    mjd::parallel_for(num_docs, cores, [&](int start, int end, int t) {
+        mjd::Vocabulary& local = local_vocabularies[t];
+        for (int i = start; i < end; ++i) {
+            range_of_document[i] = t;
+            std::vector<int>& doc = ids[i];
+            tokenizer.tokenize(documents[i].data(), documents[i].size(),
+                               [&](const std::string& token) {
+                                   doc.push_back(local.intern(token));
+                               });
+        }
+    });
+
+    mjd::Vocabulary vocabulary;
+    std::vector<std::vector<int> > remaps = vocabulary.merge(local_vocabularies);
+    for (int i = 0; i < num_docs; ++i) {
+        const std::vector<int>& remap = remaps[range_of_document[i]];
+        IntegerVector doc(ids[i].size());
+        for (size_t k = 0; k < ids[i].size(); ++k) {
+            // one based ids for use on the R side.
+            doc[k] = remap[ids[i][k]] + 1;
+        }
+        document_tokens[i] = doc;
+    }
+    to_return[0] = document_tokens;
+    to_return[1] = mjd::utf8_character_vector(vocabulary.all_terms());
+    return to_return;
+}
@@ -0,0 +1,255 @@
+#ifndef SPEEDREADER_TOKENIZER_H
+#define SPEEDREADER_TOKENIZER_H
+
+#include <string>
+#include <vector>
+#include <cstring>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace mjd {
+
+    // How code points outside of ASCII are treated. The R side probes the
+    // user's regex to pick one of these (see native_tokenizer_spec()).
+    enum NonAsciiMode {
+        NON_ASCII_SEPARATE = 0,  // every non-ASCII character splits tokens
+        NON_ASCII_LETTERS = 1,   // non-ASCII letters are kept, the rest split
+        NON_ASCII_KEEP = 2       // every non-space non-ASCII character is kept
+    };
+
+    inline bool is_unicode_space(unsigned int cp) {
+        return cp == 0x85 || cp == 0xA0 || cp == 0x1680 ||
+            (cp >= 0x2000 && cp <= 0x200A) || cp == 0x2028 || cp == 0x2029 ||
+            cp == 0x202F || cp == 0x205F || cp == 0x3000;
+    }
+
+    // An approximation of the Unicode letter category that covers the Latin,
+    // Greek, Cyrillic and CJK blocks we see in practice, while treating the
+    // general punctuation, symbol and arrow blocks as non-letters.
+    inline bool is_unicode_letter(unsigned int cp) {
+        if (cp < 0xC0) {
+            return cp == 0xAA || cp == 0xB5 || cp == 0xBA;
+        }
+        if (cp == 0xD7 || cp == 0xF7) {
+            return false;
+        }
+        if (cp >= 0x2000 && cp <= 0x2BFF) {
+            return false;
+        }
+        if (cp >= 0x3000 && cp <= 0x303F) {
+            return false;
+        }
+        if (cp >= 0xFE30 && cp <= 0xFE4F) {
+            return false;
+        }
+        if ((cp >= 0xFF00 && cp <= 0xFF20) || (cp >= 0xFF3B && cp <= 0xFF40) ||
+            (cp >= 0xFF5B && cp <= 0xFF65)) {
+            return false;
+        }
+        return true;
+    }
+
+    // Lowercase mapping for the Latin-1, Latin Extended-A, Greek and Cyrillic
+    // blocks, mirroring what tolower() does in a UTF-8 locale.
+    inline unsigned int unicode_tolower(unsigned int cp) {
+        if (cp >= 0xC0 && cp <= 0xDE && cp != 0xD7) {
+            return cp + 0x20;
+        }
+        if (cp >= 0x100 && cp <= 0x17F) {
+            if ((cp >= 0x139 && cp <= 0x148) || (cp >= 0x179 && cp <= 0x17E)) {
+                return (cp % 2 == 1) ? cp + 1 : cp;
+            }
+            if (cp == 0x130 || cp == 0x131 || cp == 0x138 || cp == 0x149 ||
+                cp == 0x17F) {
+                return cp;
+            }
+            if (cp == 0x178) {
+                return 0xFF;
+            }
+            return (cp % 2 == 0) ? cp + 1 : cp;
+        }
+        if (cp >= 0x391 && cp <= 0x3AB && cp != 0x3A2) {
+            return cp + 0x20;
+        }
+        if (cp >= 0x410 && cp <= 0x42F) {
+            return cp + 0x20;
+        }
+        if (cp >= 0x400 && cp <= 0x40F) {
+            return cp + 0x50;
+        }
+        return cp;
+    }
+
+    inline void append_utf8(std::string& out, unsigned int cp) {
+        if (cp < 0x80) {
+            out += char(cp);
+        } else if (cp < 0x800) {
+            out += char(0xC0 | (cp >> 6));
+            out += char(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            out += char(0xE0 | (cp >> 12));
+            out += char(0x80 | ((cp >> 6) & 0x3F));
+            out += char(0x80 | (cp & 0x3F));
+        } else {
+            out += char(0xF0 | (cp >> 18));
+            out += char(0x80 | ((cp >> 12) & 0x3F));
+            out += char(0x80 | ((cp >> 6) & 0x3F));
+            out += char(0x80 | (cp & 0x3F));
+        }
+    }
+
+    // decode one UTF-8 code point starting at text[i]. Returns the number of
+    // bytes consumed, or 0 if the sequence is malformed.
+    inline int decode_utf8(const unsigned char* text, size_t len, size_t i,
+                           unsigned int& cp) {
+        unsigned char b = text[i];
+        int n = 0;
+        if ((b & 0xE0) == 0xC0) {
+            n = 2;
+            cp = b & 0x1F;
+        } else if ((b & 0xF0) == 0xE0) {
+            n = 3;
+            cp = b & 0x0F;
+        } else if ((b & 0xF8) == 0xF0) {
+            n = 4;
+            cp = b & 0x07;
+        } else {
+            return 0;
+        }
+        if (i + n > len) {
+            return 0;
+        }
+        for (int k = 1; k < n; ++k) {
+            unsigned char c = text[i + k];
+            if ((c & 0xC0) != 0x80) {
+                return 0;
+            }
+            cp = (cp << 6) | (c & 0x3F);
+        }
+        return n;
+    }
+
+    // Table driven replacement for the tolower() -> str_replace_all(regex) ->
+    // str_replace_all("[\\s]+") -> str_split() sequence in
+    // clean_document_text(). keep_ascii has 128 entries, one per ASCII
+    // character, that are non-zero if the lowercased character survives the
+    // user's regex. Whitespace always separates tokens.
+    class Tokenizer {
+    public:
+        Tokenizer(const std::vector<int>& keep_ascii, int non_ascii_mode)
+            : non_ascii_mode(non_ascii_mode) {
+            std::memset(keep, 0, sizeof(keep));
+            for (int c = 0; c < 128 && c < int(keep_ascii.size()); ++c) {
+                keep[c] = keep_ascii[c] != 0;
+            }
+            // whitespace always separates, regardless of what the table says.
+            keep[int(' ')] = keep[int('\t')] = keep[int('\n')] = 0;
+            keep[int('\r')] = keep[int('\f')] = keep[int('\v')] = 0;
+            keep[0] = 0;
+            letters_only = true;
+            for (int c = 0; c < 128; ++c) {
+                bool letter = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+                if (bool(keep[c]) != letter) {
+                    letters_only = false;
+                }
+                lower[c] = (c >= 'A' && c <= 'Z') ? char(c + 32) : char(c);
+            }
+        }
+
+        // call emit(token) for every token in text. The string passed to emit
+        // is reused between calls.
+        template <typename F>
+        void tokenize(const char* input, size_t len, F emit) const {
+            const unsigned char* text =
+                reinterpret_cast<const unsigned char*>(input);
+            std::string token;
+            token.reserve(32);
+            size_t i = 0;
+            while (i < len) {
+#if defined(__SSE2__)
+                if (letters_only && i + 16 <= len) {
+                    // runs of ASCII letters or separators are handled sixteen
+                    // bytes at a time.
+                    __m128i chunk = _mm_loadu_si128(
+                        reinterpret_cast<const __m128i*>(text + i));
+                    __m128i folded = _mm_or_si128(chunk, _mm_set1_epi8(0x20));
+                    __m128i is_letter = _mm_and_si128(
+                        _mm_cmpgt_epi8(folded, _mm_set1_epi8('a' - 1)),
+                        _mm_cmplt_epi8(folded, _mm_set1_epi8('z' + 1)));
+                    unsigned int letters = _mm_movemask_epi8(is_letter);
+                    unsigned int high = _mm_movemask_epi8(chunk);
+                    if (letters & 1) {
+                        int run = (letters == 0xFFFF) ? 16 :
+                            __builtin_ctz(~letters);
+                        char lowered[16];
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(lowered),
+                                         folded);
+                        token.append(lowered, run);
+                        i += run;
+                        continue;
+                    }
+                    unsigned int stops = letters | high;
+                    if (!(stops & 1)) {
+                        int run = (stops == 0) ? 16 : __builtin_ctz(stops);
+                        if (!token.empty()) {
+                            emit(token);
+                            token.clear();
+                        }
+                        i += run;
+                        continue;
+                    }
+                }
+#endif
+                unsigned char b = text[i];
+                if (b < 0x80) {
+                    if (keep[b]) {
+                        token += lower[b];
+                    } else if (!token.empty()) {
+                        emit(token);
+                        token.clear();
+                    }
+                    i += 1;
+                    continue;
+                }
+                unsigned int cp = 0;
+                int n = decode_utf8(text, len, i, cp);
+                bool kept = false;
+                if (n > 0 && !is_unicode_space(cp)) {
+                    if (non_ascii_mode == NON_ASCII_KEEP) {
+                        kept = true;
+                    } else if (non_ascii_mode == NON_ASCII_LETTERS) {
+                        kept = is_unicode_letter(cp);
+                    }
+                }
+                if (kept) {
+                    append_utf8(token, unicode_tolower(cp));
+                } else if (!token.empty()) {
+                    emit(token);
+                    token.clear();
+                }
+                i += (n > 0) ? n : 1;
+            }
+            if (!token.empty()) {
+                emit(token);
+            }
+        }
+
+        void tokenize(const std::string& text,
+                      std::vector<std::string>& out) const {
+            tokenize(text.data(), text.size(),
+                     [&out](const std::string& token) {
+                         out.push_back(token);
+                     });
+        }
+
+    private:
+        unsigned char keep[128];
+        char lower[128];
+        bool letters_only;
+        int non_ascii_mode;
+    };
+
+}
+
+#endif
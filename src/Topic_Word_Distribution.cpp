@@ -0,0 +1,139 @@
+// [[Rcpp::plugins(cpp11)]]
+#include <RcppArmadillo.h>
+#include <vector>
+#include "Parallel.h"
+#include "Topic_Words.h"
+//[[Rcpp::depends(RcppArmadillo)]]
+using namespace Rcpp;
+
+namespace mjd {
+    CharacterVector utf8_character_vector(const std::vector<std::string>& v);
+}
+
+// Smoothed topic-word predictive distributions from sparse one based term x
+// topic count triplets (i, j, v), as returned by Read_Mallet_State(). Topics
+// are handled in parallel. Returns the tokens assigned to each topic, the full
+// topics x terms distribution (or an empty matrix unless full_distribution),
+// and topics x num_top_words matrices of the one based indices and
+// probabilities of each topic's most probable terms (NA where a topic has
+// fewer terms with tokens assigned).
+// [[Rcpp::export]]
+List Topic_Word_Distribution(std::vector<int> terms,
+                             std::vector<int> topics,
+                             std::vector<double> counts,
+                             int num_terms,
+                             int num_topics,
+                             double beta,
+                             int num_top_words,
+                             bool full_distribution,
+                             int cores){
+
+    // group the entries by topic.
+    std::vector<std::vector<std::pair<int, double> > > by_topic(num_topics);
+    std::vector<double> totals(num_topics, 0);
+    for (size_t k = 0; k < terms.size(); ++k) {
+        if (terms[k] < 1 || terms[k] > num_terms ||
+            topics[k] < 1 || topics[k] > num_topics) {
+            Rcpp::stop("The term topic counts have an entry outside of their dimensions.");
+        }
+        by_topic[topics[k] - 1].push_back(std::make_pair(terms[k] - 1, counts[k]));
+        totals[topics[k] - 1] += counts[k];
+    }
+
+    arma::mat distribution;
+    if (full_distribution) {
+        distribution = arma::zeros(num_topics, num_terms);
+    }
+    std::vector<std::vector<std::pair<int, double> > > top(num_topics);
+    mjd::parallel_for(num_topics, cores, [&](int start, int end, int t) {
+        for (int topic = start; topic < end; ++topic) {
+            if (full_distribution) {
+                double smoothed = mjd::predictive_probability(
+                    0, totals[topic], beta, num_terms);
+                for (int term = 0; term < num_terms; ++term) {
+                    distribution(topic, term) = smoothed;
+                }
+                for (size_t k = 0; k < by_topic[topic].size(); ++k) {
+                    distribution(topic, by_topic[topic][k].first) =
+                        mjd::predictive_probability(by_topic[topic][k].second,
+                                                    totals[topic], beta,
+                                                    num_terms);
+                }
+            }
+            top[topic] = by_topic[topic];
+            mjd::top_entries(top[topic], num_top_words);
+        }
+    });
+
+    IntegerMatrix top_terms(num_topics, num_top_words);
+    NumericMatrix top_probabilities(num_topics, num_top_words);
+    for (int topic = 0; topic < num_topics; ++topic) {
+        for (int k = 0; k < num_top_words; ++k) {
+            if (size_t(k) < top[topic].size()) {
+                top_terms(topic, k) = top[topic][k].first + 1;
+                top_probabilities(topic, k) = mjd::predictive_probability(
+                    top[topic][k].second, totals[topic], beta, num_terms);
+            } else {
+                top_terms(topic, k) = NA_INTEGER;
+                top_probabilities(topic, k) = NA_REAL;
+            }
+        }
+    }
+
+    List to_return(4);
+    to_return[0] = NumericVector(totals.begin(), totals.end());
+    to_return[1] = distribution;
+    to_return[2] = top_terms;
+    to_return[3] = top_probabilities;
+    return to_return;
+}
+
+// Expands sparse one based document term triplets (i, j, v) into one string
+// per document, each term repeated by its count and separated by spaces, in
+// the order the triplets appear within each document. Documents are built
+// in parallel.
+// [[Rcpp::export]]
+CharacterVector Sparse_Document_Text(std::vector<int> documents,
+                                     std::vector<int> terms,
+                                     std::vector<double> counts,
+                                     std::vector<std::string> vocabulary,
+                                     int num_documents,
+                                     int cores){
+
+    // stable counting sort of the entries by document.
+    std::vector<size_t> starts(num_documents + 1, 0);
+    for (size_t k = 0; k < documents.size(); ++k) {
+        if (documents[k] < 1 || documents[k] > num_documents ||
+            terms[k] < 1 || size_t(terms[k]) > vocabulary.size()) {
+            Rcpp::stop("The document term matrix has an entry outside of its dimensions.");
+        }
+        starts[documents[k]] += 1;
+    }
+    for (int d = 0; d < num_documents; ++d) {
+        starts[d + 1] += starts[d];
+    }
+    std::vector<size_t> order(documents.size());
+    std::vector<size_t> next(starts.begin(), starts.end() - 1);
+    for (size_t k = 0; k < documents.size(); ++k) {
+        order[next[documents[k] - 1]++] = k;
+    }
+
+    std::vector<std::string> text(num_documents);
+    mjd::parallel_for(num_documents, cores, [&](int start, int end, int t) {
+        for (int d = start; d < end; ++d) {
+            bool first = true;
+            for (size_t k = starts[d]; k < starts[d + 1]; ++k) {
+                const std::string& term = vocabulary[terms[order[k]] - 1];
+                for (double c = 0; c < counts[order[k]]; c += 1) {
+                    if (!first) {
+                        text[d].push_back(' ');
+                    }
+                    text[d].append(term);
+                    first = false;
+                }
+            }
+        }
+    });
+
+    return mjd::utf8_character_vector(text);
+}
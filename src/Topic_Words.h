@@ -0,0 +1,89 @@
+#ifndef SPEEDREADER_TOPIC_WORDS_H
+#define SPEEDREADER_TOPIC_WORDS_H
+
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+
+namespace mjd {
+
+    // Sparse term x topic token counts from a Gibbs sampling state. Each
+    // thread counts the tokens it parses into its own table, and the tables
+    // are summed once every token has been seen, so no locking is needed.
+    class TopicWordCounts {
+    public:
+        TopicWordCounts(int num_topics, int threads)
+            : num_topics(num_topics), tables(threads) {}
+
+        void add(int thread, uint64_t term, int topic) {
+            tables[thread][term * num_topics + topic] += 1;
+        }
+
+        // Sums the per-thread tables into (term, topic, count) triplets,
+        // ordered by term and then topic, and clears them.
+        void merge(std::vector<uint64_t>& terms,
+                   std::vector<int>& topics,
+                   std::vector<double>& counts) {
+            for (size_t t = 1; t < tables.size(); ++t) {
+                for (Table::const_iterator it = tables[t].begin();
+                     it != tables[t].end(); ++it) {
+                    tables[0][it->first] += it->second;
+                }
+                Table().swap(tables[t]);
+            }
+            std::vector<uint64_t> keys;
+            keys.reserve(tables[0].size());
+            for (Table::const_iterator it = tables[0].begin();
+                 it != tables[0].end(); ++it) {
+                keys.push_back(it->first);
+            }
+            std::sort(keys.begin(), keys.end());
+            terms.resize(keys.size());
+            topics.resize(keys.size());
+            counts.resize(keys.size());
+            for (size_t k = 0; k < keys.size(); ++k) {
+                terms[k] = keys[k] / num_topics;
+                topics[k] = keys[k] % num_topics;
+                counts[k] = tables[0][keys[k]];
+            }
+            Table().swap(tables[0]);
+        }
+
+    private:
+        typedef std::unordered_map<uint64_t, double> Table;
+        int num_topics;
+        std::vector<Table> tables;
+    };
+
+    // Predictive probability of a term under a topic with symmetric Dirichlet
+    // smoothing beta: (n_kw + beta) / (n_k + V * beta).
+    inline double predictive_probability(double count,
+                                         double topic_total,
+                                         double beta,
+                                         int num_terms) {
+        return (count + beta) / (topic_total + num_terms * beta);
+    }
+
+    // The (term, count) entries of one topic ordered by decreasing count,
+    // with ties going to the lower term index, truncated to the first n.
+    inline void top_entries(std::vector<std::pair<int, double> >& entries,
+                            size_t n) {
+        struct ByCount {
+            bool operator()(const std::pair<int, double>& a,
+                            const std::pair<int, double>& b) const {
+                if (a.second != b.second) {
+                    return a.second > b.second;
+                }
+                return a.first < b.first;
+            }
+        };
+        n = std::min(n, entries.size());
+        std::partial_sort(entries.begin(), entries.begin() + n, entries.end(),
+                          ByCount());
+        entries.resize(n);
+    }
+
+}
+
+#endif
@@ -2,6 +2,7 @@
 #include <RcppArmadillo.h>
 #include <string>
 #include <unordered_set>
+#include "Telemetry.h"
 //[[Rcpp::depends(RcppArmadillo)]]
 // [[Rcpp::depends(BH)]]
 using namespace Rcpp;
@@ -332,7 +333,6 @@ List Variable_Dice_Coefficients(
 
             //Rcpp::Rcout << "Both: " <<  both_count  <<std::endl;
             double dice = (2*both_count)/double(bigrams_1a.size() + bigrams_2a.size());
-            Rcpp::Rcout << "Dice Coefficient: " <<  dice  <<std::endl;
             linewise_dice_coefficients(i,j) = dice;
             both_in_a(i,j) = both_count/double(bigrams_1a.size());
             both_in_b(i,j) = both_count/double(bigrams_2a.size());
@@ -341,6 +341,8 @@ List Variable_Dice_Coefficients(
             both(i,j) = both_count;
         }
     }
+    mjd::telemetry().counter("Variable_Dice_Coefficients.comparisons") +=
+        uint64_t(number_of_lines) * number_of_lines2;
     List to_return(6);
     to_return[0] = linewise_dice_coefficients;
     to_return[1] = both_in_a;
@@ -0,0 +1,116 @@
+#ifndef SPEEDREADER_VOCABULARY_H
+#define SPEEDREADER_VOCABULARY_H
+
+#include <string>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <unordered_map>
+
+namespace mjd {
+
+    // A string interning table. Terms receive zero based ids in the order in
+    // which they are first seen, which matches the ordering Count_Words()
+    // produces for the same input.
+    class Vocabulary {
+    public:
+        Vocabulary() {}
+
+        explicit Vocabulary(const std::vector<std::string>& terms) {
+            for (size_t i = 0; i < terms.size(); ++i) {
+                intern(terms[i]);
+            }
+        }
+
+        int intern(const std::string& term) {
+            std::unordered_map<std::string, int>::const_iterator got =
+                lookup.find(term);
+            if (got != lookup.end()) {
+                return got->second;
+            }
+            int id = terms.size();
+            lookup.insert(std::make_pair(term, id));
+            terms.push_back(term);
+            return id;
+        }
+
+        // returns -1 if the term is not in the vocabulary.
+        int find(const std::string& term) const {
+            std::unordered_map<std::string, int>::const_iterator got =
+                lookup.find(term);
+            if (got == lookup.end()) {
+                return -1;
+            }
+            return got->second;
+        }
+
+        int size() const {
+            return terms.size();
+        }
+
+        const std::string& term(int id) const {
+            return terms[id];
+        }
+
+        const std::vector<std::string>& all_terms() const {
+            return terms;
+        }
+
+        void reserve(size_t n) {
+            lookup.reserve(n);
+            terms.reserve(n);
+        }
+
+        // Merge a set of per-thread vocabularies (in thread order) into this
+        // one. Returns one remap array per input giving the id of each local
+        // term in the merged vocabulary.
+        std::vector<std::vector<int> > merge(
+                const std::vector<Vocabulary>& locals) {
+            std::vector<std::vector<int> > remaps(locals.size());
+            for (size_t t = 0; t < locals.size(); ++t) {
+                const std::vector<std::string>& local = locals[t].all_terms();
+                remaps[t].resize(local.size());
+                for (size_t k = 0; k < local.size(); ++k) {
+                    remaps[t][k] = intern(local[k]);
+                }
+            }
+            return remaps;
+        }
+
+        // Gives term id k the id new_ids[k], where new_ids is a permutation
+        // of 0 ... size() - 1.
+        void renumber(const std::vector<int>& new_ids) {
+            std::vector<std::string> renumbered(terms.size());
+            for (size_t k = 0; k < terms.size(); ++k) {
+                renumbered[new_ids[k]].swap(terms[k]);
+            }
+            terms.swap(renumbered);
+            for (size_t k = 0; k < terms.size(); ++k) {
+                lookup[terms[k]] = k;
+            }
+        }
+
+    private:
+        std::unordered_map<std::string, int> lookup;
+        std::vector<std::string> terms;
+    };
+
+    // New ids that rank terms by descending count (ties keep their current
+    // order), so the most frequent terms share the first cache lines of
+    // every per-term array. Entry k is the new id of term k.
+    inline std::vector<int> frequency_ranking(const std::vector<double>& counts) {
+        std::vector<int> order(counts.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+            return counts[a] > counts[b];
+        });
+        std::vector<int> new_ids(counts.size());
+        for (size_t r = 0; r < order.size(); ++r) {
+            new_ids[order[r]] = r;
+        }
+        return new_ids;
+    }
+
+}
+
+#endif
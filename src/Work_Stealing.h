@@ -0,0 +1,137 @@
+#ifndef SPEEDREADER_WORK_STEALING_H
+#define SPEEDREADER_WORK_STEALING_H
+
+#include <thread>
+#include <mutex>
+#include <deque>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include "Parallel.h"
+
+namespace mjd {
+
+    // A contiguous range [begin, end) of work items and their summed cost.
+    struct WorkTask {
+        int begin;
+        int end;
+        double cost;
+    };
+
+    // Group items [0, n) into contiguous tasks of roughly equal estimated
+    // cost: about tasks_per_thread tasks for each of threads threads, with any
+    // single item costing more than that target given a task of its own.
+    inline std::vector<WorkTask> cost_balanced_tasks(const std::vector<double>& costs,
+                                                     int threads,
+                                                     int tasks_per_thread) {
+        int n = costs.size();
+        double total = 0;
+        for (int i = 0; i < n; ++i) {
+            total += costs[i];
+        }
+        double target = total / std::max(1, threads * tasks_per_thread);
+        std::vector<WorkTask> tasks;
+        WorkTask current = {0, 0, 0};
+        for (int i = 0; i < n; ++i) {
+            if (current.end > current.begin && current.cost + costs[i] > target) {
+                tasks.push_back(current);
+                current.begin = i;
+                current.cost = 0;
+            }
+            current.end = i + 1;
+            current.cost += costs[i];
+        }
+        if (current.end > current.begin) {
+            tasks.push_back(current);
+        }
+        return tasks;
+    }
+
+    // A deque of tasks per thread. Tasks are dealt out largest first, in
+    // turn, so every thread starts on its most expensive work. A thread takes
+    // its own tasks from the front of its deque, and once that is empty
+    // steals the cheapest remaining task from the back of another thread's,
+    // so the last tasks to run are small ones wherever they were dealt.
+    class WorkStealingQueues {
+    public:
+        WorkStealingQueues(std::vector<WorkTask> tasks, int threads)
+            : queues(threads), locks(threads), stolen(0) {
+            std::stable_sort(tasks.begin(), tasks.end(),
+                             [](const WorkTask& a, const WorkTask& b) {
+                                 return a.cost > b.cost;
+                             });
+            for (size_t k = 0; k < tasks.size(); ++k) {
+                queues[k % threads].push_back(tasks[k]);
+            }
+        }
+
+        // the next task for thread t, or false once every deque is empty.
+        bool next(int t, WorkTask& task) {
+            {
+                std::lock_guard<std::mutex> lock(locks[t]);
+                if (!queues[t].empty()) {
+                    task = queues[t].front();
+                    queues[t].pop_front();
+                    return true;
+                }
+            }
+            int threads = queues.size();
+            for (int k = 1; k < threads; ++k) {
+                int victim = (t + k) % threads;
+                std::lock_guard<std::mutex> lock(locks[victim]);
+                if (!queues[victim].empty()) {
+                    task = queues[victim].back();
+                    queues[victim].pop_back();
+                    ++stolen;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        long steals() const {
+            return stolen;
+        }
+
+    private:
+        std::vector<std::deque<WorkTask> > queues;
+        std::vector<std::mutex> locks;
+        std::atomic<long> stolen;
+    };
+
+    // Call f(begin, end, thread_index) on cost balanced tasks covering
+    // [0, costs.size()), scheduled over cores threads with work stealing
+    // (see WorkStealingQueues). Unlike parallel_for(), tasks run in no
+    // particular order, so f should write each item's result to its own slot.
+    // The R API must never be touched from inside f. Returns the number of
+    // tasks that were stolen.
+    template <typename F>
+    long work_stealing_for(const std::vector<double>& costs, int cores, F f) {
+        int n = costs.size();
+        int threads = resolve_cores(cores, n);
+        if (threads <= 1) {
+            if (n > 0) {
+                f(0, n, 0);
+            }
+            return 0;
+        }
+        WorkStealingQueues queues(cost_balanced_tasks(costs, threads, 16),
+                                  threads);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.push_back(std::thread([&queues, &f, t] {
+                WorkTask task;
+                while (queues.next(t, task)) {
+                    f(task.begin, task.end, t);
+                }
+            }));
+        }
+        for (size_t t = 0; t < workers.size(); ++t) {
+            workers[t].join();
+        }
+        return queues.steals();
+    }
+
+}
+
+#endif
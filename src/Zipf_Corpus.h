@@ -0,0 +1,143 @@
+#ifndef SPEEDREADER_ZIPF_CORPUS_H
+#define SPEEDREADER_ZIPF_CORPUS_H
+
+#include <string>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <cstdint>
+
+namespace mjd {
+
+    // splitmix64. Implemented here rather than taken from <random> so a seed
+    // produces the same corpus with every compiler and standard library.
+    class SeededRandom {
+    public:
+        explicit SeededRandom(uint64_t seed) : state(seed) {}
+
+        uint64_t next() {
+            uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+
+        // uniform on [0, 1).
+        double uniform() {
+            return (next() >> 11) * (1.0 / 9007199254740992.0);
+        }
+
+        // uniform on 0 ... n - 1.
+        size_t below(size_t n) {
+            return size_t(uniform() * n);
+        }
+
+        // standard normal, by Box-Muller.
+        double normal() {
+            double u = 1.0 - uniform();
+            double v = uniform();
+            return std::sqrt(-2.0 * std::log(u)) * std::cos(6.283185307179586 * v);
+        }
+
+    private:
+        uint64_t state;
+    };
+
+    // Draws zero based ranks 0 ... size - 1 with probability proportional to
+    // 1 / (rank + 1)^exponent, by binary search in the cumulative weights.
+    class ZipfSampler {
+    public:
+        ZipfSampler(size_t size, double exponent) : cumulative(size) {
+            double total = 0;
+            for (size_t r = 0; r < size; ++r) {
+                total += 1.0 / std::pow(double(r + 1), exponent);
+                cumulative[r] = total;
+            }
+            for (size_t r = 0; r < size; ++r) {
+                cumulative[r] /= total;
+            }
+        }
+
+        int sample(SeededRandom& random) const {
+            double u = random.uniform();
+            size_t r = std::upper_bound(cumulative.begin(), cumulative.end(), u) -
+                cumulative.begin();
+            return int(std::min(r, cumulative.size() - 1));
+        }
+
+    private:
+        std::vector<double> cumulative;
+    };
+
+    // The word for a zero based rank: "a" ... "z", "aa", "ab" ... so the
+    // most frequent terms are the shortest, as in natural text.
+    inline std::string zipf_term(int rank) {
+        std::string term;
+        long n = long(rank) + 1;
+        while (n > 0) {
+            n -= 1;
+            term.push_back(char('a' + n % 26));
+            n /= 26;
+        }
+        std::reverse(term.begin(), term.end());
+        return term;
+    }
+
+    struct ZipfCorpusOptions {
+        int num_documents;
+        int vocabulary_size;
+        double exponent;
+        double mean_length;
+        double length_sd;
+        double duplicate_rate;
+        double edit_rate;
+        uint64_t seed;
+    };
+
+    // Generates documents of Zipf distributed term ranks with log-normal
+    // lengths of the given mean and standard deviation (at least one
+    // token). With probability duplicate_rate, a document after the first
+    // is instead a copy of an earlier original document with each token
+    // redrawn with probability edit_rate, and duplicate_of records its
+    // source (-1 for originals).
+    inline void generate_zipf_corpus(const ZipfCorpusOptions& options,
+                                     std::vector<std::vector<int> >& documents,
+                                     std::vector<int>& duplicate_of) {
+        SeededRandom random(options.seed);
+        ZipfSampler sampler(options.vocabulary_size, options.exponent);
+        double sigma = 0;
+        double mu = std::log(options.mean_length);
+        if (options.length_sd > 0) {
+            double ratio = options.length_sd / options.mean_length;
+            sigma = std::sqrt(std::log(1 + ratio * ratio));
+            mu -= sigma * sigma / 2;
+        }
+
+        documents.assign(options.num_documents, std::vector<int>());
+        duplicate_of.assign(options.num_documents, -1);
+        std::vector<int> originals;
+        for (int d = 0; d < options.num_documents; ++d) {
+            if (!originals.empty() && random.uniform() < options.duplicate_rate) {
+                int source = originals[random.below(originals.size())];
+                documents[d] = documents[source];
+                for (size_t k = 0; k < documents[d].size(); ++k) {
+                    if (random.uniform() < options.edit_rate) {
+                        documents[d][k] = sampler.sample(random);
+                    }
+                }
+                duplicate_of[d] = source;
+                continue;
+            }
+            double length = std::exp(mu + sigma * random.normal());
+            size_t tokens = std::max(1.0, std::floor(length + 0.5));
+            documents[d].resize(tokens);
+            for (size_t k = 0; k < tokens; ++k) {
+                documents[d][k] = sampler.sample(random);
+            }
+            originals.push_back(d);
+        }
+    }
+
+}
+
+#endif
@@ -58,14 +58,6 @@ arma::vec calculate_ACMI_contribution(
 
             double change = D * (0 - term2 - column_contributions[i]);
 
-            if ( i < 10) {
-                Rcpp::Rcout  << i << " D1 : " <<  D_1  << " D2 : " <<  D_2 <<std::endl;
-                Rcpp::Rcout  << i << " sub terms: " <<  sub_term_1 << " " << sub_term_2 <<std::endl;
-                Rcpp::Rcout  << i << " D : " <<   D <<std::endl;
-                Rcpp::Rcout  << i << " C : " <<  column_contributions[i] <<std::endl;
-                Rcpp::Rcout  << i << " Change : " <<  change <<std::endl;
-            }
-
             ACMI_contribution[i] = change;
         }
     }
@@ -1,24 +1,24 @@
+// [[Rcpp::plugins(cpp11)]]
 #include <RcppArmadillo.h>
+#include "Dense_TFIDF.h"
 //[[Rcpp::depends(RcppArmadillo)]]
 using namespace Rcpp;
 
+// Number of documents each term appears in, counting the nonzero entries of
+// each column in parallel blocks of columns.
 // [[Rcpp::export]]
 arma::vec calculate_document_frequency(
-        arma::mat document_word_matrix
+        const arma::mat& document_word_matrix,
+        int cores
 ){
 
     int ndoc = document_word_matrix.n_rows;
     int vocab_size = document_word_matrix.n_cols;
     arma::vec document_frequency = arma::zeros(vocab_size);
 
-    // calculate df/idf
-    for(int i = 0; i < ndoc; ++i){
-        for(int j = 0; j < vocab_size; ++j){
-            if(document_word_matrix(i,j) > 0){
-                document_frequency[j] += 1;
-            }
-        }
-    }
+    mjd::dense_document_frequency(document_word_matrix.memptr(),
+                                  ndoc, vocab_size, cores,
+                                  document_frequency.memptr());
 
     return document_frequency;
 }
@@ -3,6 +3,7 @@
 #include <unordered_map>
 #include <chrono>
 #include <thread>
+#include "Telemetry.h"
 //[[Rcpp::depends(RcppArmadillo)]]
 // [[Rcpp::depends(BH)]]
 using namespace Rcpp;
@@ -29,7 +30,7 @@ arma::mat reference_dist_distance(
     std::vector<std::unordered_map<int,double>> lookups(num_ref_dists);
 
     // hash term weights
-    Rcpp::Rcout << "Hashing Term Weights: " << std::endl;
+    mjd::PhaseTimer hashing("reference_dist_distance.hashing");
     std::unordered_map<int,double> term_weight_map;
     int twlen = term_weights.n_elem;
     for (int i = 0; i < twlen; ++i) {
@@ -42,7 +43,6 @@ arma::mat reference_dist_distance(
 
     //loop through documents and form ngrams/hash them
     for (int i = 0; i < num_ref_dists; ++i) {
-        Rcpp::Rcout << "Hashing Reference Distribution: " << i << std::endl;
         std::unordered_map<int,double> lookup;
         while (ref_dist_i[cur] == i) {
             int temp1 = ref_dist_j[cur];
@@ -58,9 +58,13 @@ arma::mat reference_dist_distance(
     }
 
 
+    hashing.stop();
+
     // figure out its contribution to each of the distances
+    mjd::PhaseTimer comparing("reference_dist_distance.comparing");
+    mjd::Progress progress("Checking Against Reference Distribution", num_ref_dists);
     for (int j = 0; j < num_ref_dists; ++j) {
-        Rcpp::Rcout << "Checking Against Reference Distribution: " << j << " of " << num_ref_dists << std::endl;
+        progress.update(j);
         // get the current hash map
         std::unordered_map<int,double> current_lookup = lookups[j];
         //no loop through the target documents
@@ -76,9 +80,6 @@ arma::mat reference_dist_distance(
                     current_distance += weight * std::pow(target_dist_v[i],2);
                 } else {
                     double temp = got->second;
-                    if (i < 4) {
-                        Rcpp::Rcout << "Value: " << temp << " weight " << weight << std::endl;
-                    }
                     current_distance += weight * std::pow((target_dist_v[i] - temp),2);
                 }
             } else {
@@ -100,8 +101,9 @@ arma::mat reference_dist_distance(
             }
         }
     }
-
-
+    progress.finish();
+    mjd::telemetry().counter("reference_dist_distance.comparisons") +=
+        uint64_t(num_ref_dists) * num_documents;
 
     return distances;
 }